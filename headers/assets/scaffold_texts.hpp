@@ -235,18 +235,599 @@ namespace assets::scaffold_texts {
     }
     )";
 
+    const string CBT_TOOLS_ALLOC_TRACKER_HPP = R"(
+    #ifndef CBT_TOOLS_ALLOC_TRACKER
+    #define CBT_TOOLS_ALLOC_TRACKER
+
+    #include <algorithm>
+    #include <cstddef>
+    #include <cstdlib>
+    #include <cstring>
+    #include <new>
+    #include <sstream>
+    #include <stdexcept>
+    #include <string>
+
+    #if defined(_WIN32) || defined(_WIN64)
+    #include <malloc.h>
+    #endif
+
+    namespace cbt_tools::alloc_tracker {
+        struct Statistics {
+            std::size_t allocations;
+            std::size_t bytes;
+            std::size_t peak_live_bytes;
+        };
+
+        // Allocations are counted per thread, so a test case or benchmark only sees its own churn
+        struct Counters {
+            std::size_t allocations;
+            std::size_t bytes;
+            std::ptrdiff_t live_bytes;
+            std::ptrdiff_t peak_live_bytes;
+        };
+
+        inline thread_local Counters counters{};
+
+        // True only for binaries built by `cbt run-unit-tests --track-allocations` or
+        // `cbt run-benchmarks --track-allocations`; otherwise every scope observes zero allocations
+        constexpr bool is_enabled() {
+            #if defined(CBT_TRACK_ALLOCATIONS)
+            return true;
+            #else
+            return false;
+            #endif
+        }
+
+        class Scope {
+        public:
+            Scope(): start{ counters }, outer_peak_live_bytes{ counters.peak_live_bytes } {
+                counters.peak_live_bytes = counters.live_bytes;
+            }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+            ~Scope() {
+                counters.peak_live_bytes = std::max(outer_peak_live_bytes, counters.peak_live_bytes);
+            }
+
+            Statistics statistics() const {
+                return Statistics{
+                    .allocations{ counters.allocations - start.allocations },
+                    .bytes{ counters.bytes - start.bytes },
+                    .peak_live_bytes{ static_cast<std::size_t>(std::max<std::ptrdiff_t>(0, counters.peak_live_bytes - start.live_bytes)) }
+                };
+            }
+
+            // Allocation budget, e.g. `scope.expect_at_most(0)` for a hot path that must not allocate
+            void expect_at_most(const std::size_t allocations) const {
+                const std::size_t observed{ statistics().allocations };
+
+                if (observed > allocations) {
+                    throw std::runtime_error("Expected at most " + std::to_string(allocations) + " allocation(s), observed " + std::to_string(observed));
+                }
+            }
+
+        private:
+            const Counters start;
+            const std::ptrdiff_t outer_peak_live_bytes;
+        };
+
+        inline std::string describe(const Statistics& statistics) {
+            std::ostringstream stream;
+
+            stream << statistics.allocations << " allocation(s) | " << statistics.bytes << " B | peak live " << statistics.peak_live_bytes << " B";
+
+            return stream.str();
+        }
+
+        namespace detail {
+            // Every block is prefixed with its size so that deallocation can update the live bytes
+            constexpr std::size_t get_header_size(const std::size_t alignment) {
+                return std::max(alignment, alignof(std::max_align_t));
+            }
+
+            inline void* allocate(const std::size_t size, const std::size_t alignment) {
+                const std::size_t header_size{ get_header_size(alignment) };
+                void* block{ nullptr };
+
+                if (alignment <= alignof(std::max_align_t)) {
+                    block = std::malloc(size + header_size);
+                } else {
+                    #if defined(_WIN32) || defined(_WIN64)
+                    block = _aligned_malloc(size + header_size, alignment);
+                    #else
+                    block = std::aligned_alloc(alignment, (size + header_size + alignment - 1) / alignment * alignment);
+                    #endif
+                }
+
+                if (block == nullptr) {
+                    return nullptr;
+                }
+
+                std::byte* const user_block{ static_cast<std::byte*>(block) + header_size };
+                std::memcpy(user_block - sizeof(std::size_t), &size, sizeof(std::size_t));
+
+                ++counters.allocations;
+                counters.bytes += size;
+                counters.live_bytes += size;
+                counters.peak_live_bytes = std::max(counters.peak_live_bytes, counters.live_bytes);
+
+                return user_block;
+            }
+
+            inline void deallocate(void* user_block, const std::size_t alignment) {
+                if (user_block == nullptr) {
+                    return;
+                }
+
+                std::size_t size{ 0 };
+                std::memcpy(&size, static_cast<std::byte*>(user_block) - sizeof(std::size_t), sizeof(std::size_t));
+
+                counters.live_bytes -= size;
+
+                void* const block{ static_cast<std::byte*>(user_block) - get_header_size(alignment) };
+
+                #if defined(_WIN32) || defined(_WIN64)
+                if (alignment > alignof(std::max_align_t)) {
+                    _aligned_free(block);
+                    return;
+                }
+                #endif
+
+                std::free(block);
+            }
+        }
+    }
+
+    // Replacing these four is sufficient: the standard library's array, nothrow and sized forms forward to them.
+    // Being non-inline, the definitions must only be compiled once per binary, i.e. in the test/benchmark file,
+    // unless `cbt run-unit-tests` links them from its prebuilt test runtime instead.
+    #if defined(CBT_TRACK_ALLOCATIONS) && !defined(CBT_PREBUILT_TEST_RUNTIME)
+    void* operator new(std::size_t size) {
+        if (void* block = cbt_tools::alloc_tracker::detail::allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__)) {
+            return block;
+        }
+
+        throw std::bad_alloc();
+    }
+
+    void* operator new(std::size_t size, std::align_val_t alignment) {
+        if (void* block = cbt_tools::alloc_tracker::detail::allocate(size, static_cast<std::size_t>(alignment))) {
+            return block;
+        }
+
+        throw std::bad_alloc();
+    }
+
+    void operator delete(void* block) noexcept {
+        cbt_tools::alloc_tracker::detail::deallocate(block, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+    }
+
+    void operator delete(void* block, std::align_val_t alignment) noexcept {
+        cbt_tools::alloc_tracker::detail::deallocate(block, static_cast<std::size_t>(alignment));
+    }
+    #endif
+
+    #endif
+    )";
+
+    const string CBT_TOOLS_BENCH_HARNESS_HPP = R"(
+    #ifndef CBT_TOOLS_BENCH_HARNESS
+    #define CBT_TOOLS_BENCH_HARNESS
+
+    #include <algorithm>
+    #include <chrono>
+    #include <cmath>
+    #include <cstddef>
+    #include <cstdint>
+    #include <cstdlib>
+    #include <fstream>
+    #include <functional>
+    #include <iomanip>
+    #include <iostream>
+    #include <numeric>
+    #include <optional>
+    #include <sstream>
+    #include <string>
+    #include <tuple>
+    #include <utility>
+    #include <vector>
+
+    #if defined(__linux__)
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #endif
+
+    #include "cbt_tools/alloc_tracker.hpp"
+
+    namespace cbt_tools::bench_harness {
+        // Keep the compiler from discarding a value (and thereby the computation producing it)
+        template<typename T>
+        inline void do_not_optimize(const T& value) {
+            asm volatile("" : : "m"(value) : "memory");
+        }
+
+        template<typename T>
+        inline void do_not_optimize(T& value) {
+            asm volatile("" : "+m"(value) : : "memory");
+        }
+
+        // Force all pending writes to be treated as observable
+        inline void clobber_memory() {
+            asm volatile("" : : : "memory");
+        }
+
+        struct Options {
+            std::chrono::nanoseconds warmup_time{ std::chrono::milliseconds(100) };
+            std::chrono::nanoseconds min_sample_time{ std::chrono::milliseconds(10) };
+            std::size_t samples{ 30 };
+            // Also enabled by `cbt run-benchmarks --counters`
+            bool hardware_counters{ false };
+        };
+
+        struct Counter {
+            std::string name;
+            double per_iteration;
+        };
+
+        struct Statistics {
+            std::size_t iterations;
+            std::vector<double> samples;
+
+            double mean;
+            double median;
+            double p99;
+            double stddev;
+
+            std::vector<Counter> counters{};
+            // Totals over all sampled iterations, only present with `cbt run-benchmarks --track-allocations`
+            std::optional<alloc_tracker::Statistics> allocations{};
+        };
+
+        // Counts hardware events of the calling thread through `perf_event_open` (Linux only). Counters
+        // refused by the kernel (containers, restrictive `perf_event_paranoid`, etc.) are left out, and
+        // if none can be opened the harness falls back to reporting time only
+        class HardwareCounters {
+        public:
+            HardwareCounters() {
+                #if defined(__linux__)
+                open_counter("instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+                open_counter("cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+                open_counter("branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+                open_counter("L1D-misses", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+                open_counter("LLC-misses", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+                #endif
+            }
+
+            HardwareCounters(const HardwareCounters&) = delete;
+            HardwareCounters& operator=(const HardwareCounters&) = delete;
+
+            ~HardwareCounters() {
+                #if defined(__linux__)
+                for (const auto& [_, fd]: counters) {
+                    close(fd);
+                }
+                #endif
+            }
+
+            bool is_available() const {
+                return !counters.empty();
+            }
+
+            void start() const {
+                #if defined(__linux__)
+                for (const auto& [_, fd]: counters) {
+                    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+                }
+                #endif
+            }
+
+            std::vector<Counter> stop(const double iterations) const {
+                std::vector<Counter> readings;
+
+                #if defined(__linux__)
+                for (const auto& [name, fd]: counters) {
+                    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+                    std::uint64_t values[3]{};
+
+                    if (read(fd, values, sizeof(values)) == sizeof(values) && values[2] != 0) {
+                        // Scale up in case the kernel had to multiplex the counters
+                        const double scaled_value{ static_cast<double>(values[0]) * values[1] / values[2] };
+                        readings.push_back(Counter{ name, scaled_value / iterations });
+                    }
+                }
+                #else
+                (void)iterations;
+                #endif
+
+                return readings;
+            }
+
+        private:
+            #if defined(__linux__)
+            void open_counter(const std::string& name, const std::uint32_t type, const std::uint64_t config) {
+                perf_event_attr attributes{};
+
+                attributes.size = sizeof(attributes);
+                attributes.type = type;
+                attributes.config = config;
+                attributes.disabled = 1;
+                attributes.exclude_kernel = 1;
+                attributes.exclude_hv = 1;
+                attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                const long fd{ syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0) };
+
+                if (fd >= 0) {
+                    counters.push_back(std::make_tuple(name, static_cast<int>(fd)));
+                }
+            }
+            #endif
+
+            std::vector<std::tuple<std::string, int>> counters;
+        };
+
+        inline std::string format_counters(const std::vector<Counter>& counters) {
+            std::ostringstream stream;
+            stream << std::fixed << std::setprecision(2);
+
+            double instructions{ 0 };
+            double cycles{ 0 };
+
+            for (const auto& counter: counters) {
+                stream << (stream.tellp() == 0 ? "" : " | ") << counter.name << " " << counter.per_iteration;
+
+                if (counter.name == "instructions") {
+                    instructions = counter.per_iteration;
+                } else if (counter.name == "cycles") {
+                    cycles = counter.per_iteration;
+                }
+            }
+
+            if (instructions != 0 && cycles != 0) {
+                stream << " | IPC " << instructions / cycles;
+            }
+
+            return stream.str();
+        }
+
+        inline Statistics summarise(const std::size_t iterations, std::vector<double> samples) {
+            std::sort(samples.begin(), samples.end());
+
+            const std::size_t count{ samples.size() };
+            const double mean{ std::accumulate(samples.begin(), samples.end(), 0.0) / count };
+            const double median{ count % 2 == 0 ? (samples[count / 2 - 1] + samples[count / 2]) / 2 : samples[count / 2] };
+            const double p99{ samples[std::min(count - 1, static_cast<std::size_t>(std::ceil(0.99 * count)) - 1)] };
+
+            double squared_deviations{ 0.0 };
+
+            for (const double sample: samples) {
+                squared_deviations += (sample - mean) * (sample - mean);
+            }
+
+            const double stddev{ count > 1 ? std::sqrt(squared_deviations / (count - 1)) : 0.0 };
+
+            return Statistics{ iterations, samples, mean, median, p99, stddev };
+        }
+
+        inline std::string format_duration(const double nanoseconds) {
+            std::ostringstream stream;
+            stream << std::fixed << std::setprecision(2);
+
+            if (nanoseconds < 1e3) {
+                stream << nanoseconds << " ns";
+            } else if (nanoseconds < 1e6) {
+                stream << nanoseconds / 1e3 << " us";
+            } else if (nanoseconds < 1e9) {
+                stream << nanoseconds / 1e6 << " ms";
+            } else {
+                stream << nanoseconds / 1e9 << " s";
+            }
+
+            return stream.str();
+        }
+
+        // Note: Edit this parent class *only if* the harness provided is not upto your requirements
+        template<typename __CtxStruct>
+        class BenchmarkSuite {
+            using BenchmarkFn = std::function<void(const __CtxStruct&)>;
+            using Clock = std::chrono::steady_clock;
+
+        public:
+            explicit BenchmarkSuite(const __CtxStruct& ctx, const Options& options = Options{}): ctx{ ctx }, options{ options } {}
+
+            // `benchmark` is invoked once per iteration; the iteration count is calibrated automatically
+            virtual void add_benchmark(const std::string& title, const BenchmarkFn& benchmark) final {
+                benchmarks.push_back(std::make_tuple(title, benchmark));
+            }
+
+            virtual void run() final {
+                setup();
+
+                // `cbt run-benchmarks` collects the raw samples through this file to maintain baselines
+                const char* results_file_name{ std::getenv("CBT_BENCHMARK_RESULTS") };
+                std::ofstream results_file;
+
+                if (results_file_name != nullptr) {
+                    results_file.open(results_file_name, std::ios::app);
+                    results_file << std::setprecision(10);
+                }
+
+                std::optional<HardwareCounters> hardware_counters{ std::nullopt };
+
+                if (options.hardware_counters || std::getenv("CBT_BENCHMARK_COUNTERS") != nullptr) {
+                    hardware_counters.emplace();
+
+                    if (!hardware_counters->is_available()) {
+                        std::cout << std::right << std::setw(8) << "NOTE " << "Hardware counters unavailable (check 'perf_event_paranoid'), reporting time only" << std::endl;
+                        hardware_counters.reset();
+                    }
+                }
+
+                for (const auto& [title, benchmark_fn]: benchmarks) {
+                    before_each();
+
+                    std::cout << std::right << std::setw(8) << "BENCH " << title << std::endl;
+
+                    const Statistics statistics{ measure(benchmark_fn, hardware_counters.has_value() ? &hardware_counters.value() : nullptr) };
+
+                    std::cout << std::setw(8) << "" << statistics.iterations << " iterations x " << statistics.samples.size() << " samples"
+                        << " | mean " << format_duration(statistics.mean)
+                        << " | median " << format_duration(statistics.median)
+                        << " | p99 " << format_duration(statistics.p99)
+                        << " | stddev " << format_duration(statistics.stddev)
+                        << std::endl;
+
+                    if (!statistics.counters.empty()) {
+                        std::cout << std::setw(8) << "" << "per iteration: " << format_counters(statistics.counters) << std::endl;
+                    }
+
+                    const double sampled_iterations{ static_cast<double>(statistics.iterations * statistics.samples.size()) };
+
+                    if (statistics.allocations.has_value()) {
+                        std::cout << std::setw(8) << "" << std::fixed << std::setprecision(2)
+                            << "allocations per iteration: " << statistics.allocations->allocations / sampled_iterations
+                            << " | " << statistics.allocations->bytes / sampled_iterations << " B"
+                            << " | peak live " << statistics.allocations->peak_live_bytes << " B"
+                            << std::defaultfloat << std::endl;
+                    }
+
+                    if (results_file.is_open()) {
+                        results_file << statistics.iterations << "|";
+
+                        for (std::size_t i = 0; i < statistics.samples.size(); ++i) {
+                            results_file << (i == 0 ? "" : ",") << statistics.samples[i];
+                        }
+
+                        results_file << "|";
+
+                        for (std::size_t i = 0; i < statistics.counters.size(); ++i) {
+                            results_file << (i == 0 ? "" : ";") << statistics.counters[i].name << "=" << statistics.counters[i].per_iteration;
+                        }
+
+                        if (statistics.allocations.has_value()) {
+                            results_file << (statistics.counters.empty() ? "" : ";")
+                                << "allocations=" << statistics.allocations->allocations / sampled_iterations
+                                << ";allocated-bytes=" << statistics.allocations->bytes / sampled_iterations;
+                        }
+
+                        results_file << "|" << title << "\n";
+                    }
+
+                    after_each();
+                }
+
+                teardown();
+            }
+
+        protected:
+            __CtxStruct ctx;
+
+        private:
+            virtual void setup() = 0;
+            virtual void before_each() = 0;
+            virtual void after_each() = 0;
+            virtual void teardown() = 0;
+
+            std::chrono::nanoseconds run_batch(const BenchmarkFn& benchmark_fn, const std::size_t iterations) const {
+                const auto start{ Clock::now() };
+
+                for (std::size_t i = 0; i < iterations; ++i) {
+                    benchmark_fn(ctx);
+                }
+
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+            }
+
+            Statistics measure(const BenchmarkFn& benchmark_fn, const HardwareCounters* hardware_counters) const {
+                std::size_t iterations{ 1 };
+
+                // Warm up caches and branch predictors while doubling the batch size until a single
+                // batch is long enough to be timed reliably
+                const auto warmup_end{ Clock::now() + options.warmup_time };
+
+                auto elapsed{ run_batch(benchmark_fn, iterations) };
+
+                while (elapsed < options.min_sample_time || Clock::now() < warmup_end) {
+                    if (elapsed < options.min_sample_time) {
+                        iterations *= 2;
+                    }
+
+                    elapsed = run_batch(benchmark_fn, iterations);
+                }
+
+                std::vector<double> samples;
+                samples.reserve(options.samples);
+
+                const alloc_tracker::Scope scope;
+
+                if (hardware_counters != nullptr) {
+                    hardware_counters->start();
+                }
+
+                for (std::size_t sample = 0; sample < options.samples; ++sample) {
+                    samples.push_back(static_cast<double>(run_batch(benchmark_fn, iterations).count()) / iterations);
+                }
+
+                // Snapshot before reading the counters, which allocates
+                const alloc_tracker::Statistics allocations{ scope.statistics() };
+
+                std::vector<Counter> counters{};
+
+                if (hardware_counters != nullptr) {
+                    counters = hardware_counters->stop(static_cast<double>(iterations) * options.samples);
+                }
+
+                Statistics statistics{ summarise(iterations, samples) };
+                statistics.counters = std::move(counters);
+
+                if (alloc_tracker::is_enabled()) {
+                    statistics.allocations = allocations;
+                }
+
+                return statistics;
+            }
+
+            Options options;
+            std::vector<std::tuple<std::string, BenchmarkFn>> benchmarks;
+        };
+    }
+
+    #endif
+    )";
+
     const string CBT_TOOLS_TEST_HARNESS_HPP = R"(
     #ifndef CBT_TOOLS_TEST_HARNESS
     #define CBT_TOOLS_TEST_HARNESS
 
+    #include <algorithm>
+    #include <deque>
+    #include <exception>
     #include <functional>
     #include <iomanip>
     #include <iostream>
+    #include <mutex>
+    #include <optional>
     #include <string>
+    #include <thread>
     #include <tuple>
+    #include <utility>
     #include <vector>
 
+    #include "cbt_tools/alloc_tracker.hpp"
+
     namespace cbt_tools::test_harness {
+        enum class Execution {
+            SERIAL,
+            INDEPENDENT
+        };
+
         // Note: Edit this parent class *only if* the harness provided is not upto your requirements
         template<typename __CtxStruct>
         class TestSuite {
@@ -255,24 +836,25 @@ namespace assets::scaffold_texts {
         public:
             explicit TestSuite(const __CtxStruct& ctx): ctx{ ctx } {}
 
-            virtual void add_test_case(const std::string& title, const TestCaseFn& test_case) final {
-                test_cases.push_back(std::make_tuple(title, test_case));
+            virtual void add_test_case(const std::string& title, const TestCaseFn& test_case, const Execution execution = Execution::SERIAL) final {
+                test_cases.push_back(std::make_tuple(title, test_case, execution));
+            }
+
+            // Opt-in: test cases added with `Execution::INDEPENDENT` are dispatched to a work-stealing
+            // pool of `workers` threads, while the rest still run one after another on the calling thread
+            virtual void enable_parallel_execution(const unsigned int workers = std::thread::hardware_concurrency()) final {
+                this->workers = std::max(1u, workers);
             }
 
             virtual void run() final {
                 setup();
-                
-                for (const auto& test_case: test_cases) {
-                    before_each();
 
-                    const auto [title, test_fn] = test_case;
-                            
-                    std::cout << std::right << std::setw(8) << "RUN " << title << std::endl;
-                    test_fn(ctx);
-
-                    after_each();
+                if (workers == 0) {
+                    run_serially();
+                } else {
+                    run_in_parallel();
                 }
-                
+
                 teardown();
             }
 
@@ -285,7 +867,156 @@ namespace assets::scaffold_texts {
             virtual void after_each() = 0;
             virtual void teardown() = 0;
 
-            std::vector<std::tuple<std::string, TestCaseFn>> test_cases;
+            void run_serially() {
+                for (const auto& test_case: test_cases) {
+                    before_each();
+
+                    const auto [title, test_fn, _] = test_case;
+                            
+                    std::cout << std::right << std::setw(8) << "RUN " << title << std::endl;
+
+                    const alloc_tracker::Scope scope;
+                    test_fn(ctx);
+
+                    if (alloc_tracker::is_enabled()) {
+                        std::cout << std::right << std::setw(8) << "ALLOC " << alloc_tracker::describe(scope.statistics()) << std::endl;
+                    }
+
+                    after_each();
+                }
+            }
+
+            void run_in_parallel() {
+                std::vector<std::exception_ptr> failures(test_cases.size());
+                std::vector<alloc_tracker::Statistics> allocations(test_cases.size());
+
+                std::vector<std::deque<std::size_t>> queues(workers);
+                std::vector<std::mutex> queue_locks(workers);
+                std::mutex hook_lock;
+
+                std::size_t next_queue{ 0 };
+
+                for (std::size_t index = 0; index < test_cases.size(); ++index) {
+                    if (std::get<2>(test_cases[index]) == Execution::INDEPENDENT) {
+                        queues[next_queue++ % workers].push_back(index);
+                    }
+                }
+
+                // Owners pop from the back of their own queue, thieves steal from the front of others'.
+                // No work is added once the pool starts, so an empty sweep means everything is taken.
+                auto take = [&](const std::size_t worker) -> std::optional<std::size_t> {
+                    for (std::size_t offset = 0; offset < workers; ++offset) {
+                        const std::size_t victim{ (worker + offset) % workers };
+                        std::scoped_lock lock(queue_locks[victim]);
+
+                        if (!queues[victim].empty()) {
+                            const std::size_t index{ offset == 0 ? queues[victim].back() : queues[victim].front() };
+
+                            if (offset == 0) {
+                                queues[victim].pop_back();
+                            } else {
+                                queues[victim].pop_front();
+                            }
+
+                            return index;
+                        }
+                    }
+
+                    return std::nullopt;
+                };
+
+                // `before_each()` and `after_each()` act upon `ctx`, so every worker swaps its own copy of
+                // the context in while the hook runs; hooks are serialised, test cases are not
+                auto run_hook = [&](const std::function<void()>& hook, __CtxStruct& worker_ctx) {
+                    std::scoped_lock lock(hook_lock);
+
+                    std::swap(ctx, worker_ctx);
+
+                    try {
+                        hook();
+                    } catch (...) {
+                        std::swap(ctx, worker_ctx);
+                        throw;
+                    }
+
+                    std::swap(ctx, worker_ctx);
+                };
+
+                auto work = [&](const std::size_t worker, __CtxStruct& worker_ctx) {
+                    while (const auto index = take(worker)) {
+                        try {
+                            run_hook([this](){ before_each(); }, worker_ctx);
+                            {
+                                const alloc_tracker::Scope scope;
+                                std::get<1>(test_cases[*index])(worker_ctx);
+                                allocations[*index] = scope.statistics();
+                            }
+                            run_hook([this](){ after_each(); }, worker_ctx);
+                        } catch (...) {
+                            failures[*index] = std::current_exception();
+                        }
+                    }
+                };
+
+                // Copied before any worker starts, as running workers swap their copy into `ctx`
+                std::vector<__CtxStruct> worker_contexts(workers, ctx);
+                std::vector<std::thread> pool;
+
+                for (std::size_t worker = 0; worker < workers; ++worker) {
+                    pool.emplace_back(work, worker, std::ref(worker_contexts[worker]));
+                }
+
+                for (auto& thread: pool) {
+                    thread.join();
+                }
+
+                for (std::size_t index = 0; index < test_cases.size(); ++index) {
+                    if (std::get<2>(test_cases[index]) == Execution::SERIAL) {
+                        try {
+                            before_each();
+                            {
+                                const alloc_tracker::Scope scope;
+                                std::get<1>(test_cases[index])(ctx);
+                                allocations[index] = scope.statistics();
+                            }
+                            after_each();
+                        } catch (...) {
+                            failures[index] = std::current_exception();
+                        }
+                    }
+                }
+
+                std::exception_ptr first_failure{ nullptr };
+
+                for (std::size_t index = 0; index < test_cases.size(); ++index) {
+                    std::cout << std::right << std::setw(8) << "RUN " << std::get<0>(test_cases[index]) << std::endl;
+
+                    if (alloc_tracker::is_enabled() && !failures[index]) {
+                        std::cout << std::right << std::setw(8) << "ALLOC " << alloc_tracker::describe(allocations[index]) << std::endl;
+                    }
+
+                    if (failures[index]) {
+                        try {
+                            std::rethrow_exception(failures[index]);
+                        } catch (const std::exception& e) {
+                            std::cout << std::right << std::setw(8) << "FAIL " << e.what() << std::endl;
+                        } catch (...) {
+                            std::cout << std::right << std::setw(8) << "FAIL " << "<unknown exception>" << std::endl;
+                        }
+
+                        if (!first_failure) {
+                            first_failure = failures[index];
+                        }
+                    }
+                }
+
+                if (first_failure) {
+                    std::rethrow_exception(first_failure);
+                }
+            }
+
+            std::vector<std::tuple<std::string, TestCaseFn, Execution>> test_cases;
+            unsigned int workers{ 0 };
         };
     }
 
@@ -757,6 +1488,15 @@ namespace assets::scaffold_texts {
             assert((sum(5, 6) != 12));
         });
 
+        test_suite.add_test_case("Sum of 5 and 6 does not allocate", []([[maybe_unused]] const Context& ctx) {
+            // Budgets are only enforced with `cbt run-unit-tests --track-allocations`
+            const cbt_tools::alloc_tracker::Scope scope;
+
+            assert((sum(5, 6) == 11));
+
+            scope.expect_at_most(0);
+        });
+
         test_suite.add_test_case("Company foundation strength is 1", []([[maybe_unused]] const Context& ctx) {
             SampleCompany company("MyCompany", "MyLocation", Employee{
                 .id{ "#E1" },
@@ -766,7 +1506,7 @@ namespace assets::scaffold_texts {
             });
 
             assert((company.strength() == 1));
-        });
+        }, cbt_tools::test_harness::Execution::INDEPENDENT);
 
         test_suite.add_test_case("Company's strength is 3 upon hiring of 2 candidates", []([[maybe_unused]] const Context& ctx) {
             SampleCompany company("MyCompany", "MyLocation", Employee{
@@ -780,7 +1520,7 @@ namespace assets::scaffold_texts {
             company.hire(Person{ .first_name{ "F2" }, .last_name{ "L2" }, .sex{ Sex::FEMALE } });
 
             assert((company.strength() == 3));
-        });
+        }, cbt_tools::test_harness::Execution::INDEPENDENT);
     }
 
     int main() {
@@ -790,12 +1530,89 @@ namespace assets::scaffold_texts {
 
         define_test_cases(test_suite);
 
+        // Uncomment to run test cases marked `Execution::INDEPENDENT` on a thread pool
+        // test_suite.enable_parallel_execution();
+
         test_suite.run();
 
         return EXIT_SUCCESS;
     }
     )";
 
+    const string SAMPLE_BENCHMARK_CPP = R"(
+    #include "cbt_tools/bench_harness.hpp"
+
+    #include <cstdlib>
+    #include <iostream>
+    #include <numeric>
+    #include <string>
+    #include <vector>
+
+    // Include the header(s) of the file(s) to benchmark here, e.g. `#include "some_module/some_util.hpp"`.
+    // The corresponding binaries are linked automatically when running `cbt run-benchmarks`.
+
+    // If no context is required, replace the below struct with just `struct Context {};`
+    // and refactor such occurrences accordingly
+    struct Context {
+        std::vector<int> numbers;
+    };
+
+    class ScopedBenchmarkSuite: public cbt_tools::bench_harness::BenchmarkSuite<Context> {
+    public:
+        explicit ScopedBenchmarkSuite(const Context& ctx): cbt_tools::bench_harness::BenchmarkSuite<Context>(ctx) {}
+
+    private:
+        void setup() override {
+            // Add necessary code here
+        }
+        void before_each() override {
+            // Add necessary code here
+        }
+        void after_each() override {
+            // Add necessary code here
+        }
+        void teardown() override {
+            // Add necessary code here
+        }
+    };
+
+    Context define_context() {
+        // Define your context here
+
+        return Context{
+            .numbers{ std::vector<int>(1024, 1) }
+        };
+    }
+
+    void define_benchmarks(ScopedBenchmarkSuite& bench_suite) {
+        // Add all your benchmarks in this function
+
+        using namespace cbt_tools::bench_harness;
+
+        bench_suite.add_benchmark("Accumulate 1024 integers", [](const Context& ctx) {
+            do_not_optimize(std::accumulate(ctx.numbers.begin(), ctx.numbers.end(), 0));
+        });
+
+        bench_suite.add_benchmark("Copy 1024 integers", [](const Context& ctx) {
+            std::vector<int> copy(ctx.numbers);
+            do_not_optimize(copy.data());
+            clobber_memory();
+        });
+    }
+
+    int main() {
+        ScopedBenchmarkSuite bench_suite{ define_context() };
+
+        std::cout << std::endl << std::setw(8) << "EXECUTE " << __FILE__ << std::endl << std::endl;
+
+        define_benchmarks(bench_suite);
+
+        bench_suite.run();
+
+        return EXIT_SUCCESS;
+    }
+    )";
+
     const string LICENSE_TXT = R"(
     This is a sample license file.
 
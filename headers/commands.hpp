@@ -1,6 +1,8 @@
 #ifndef COMMANDS
 #define COMMANDS
 
+#include <optional>
+#include <set>
 #include <string>
 
 namespace commands {
@@ -8,15 +10,31 @@ namespace commands {
     void create_library(const std::string& project_name);
     
     void create_file(const std::string& file_name, const bool requires_c_linkage = false);
+    void create_benchmark(const std::string& benchmark_name);
 
     void resolve_dependencies();
 
-    void compile_project(const bool compile_as_dependency = false);
+    // `position_independent` forces '-fPIC' onto a dependency, for the project depending on it to link it into a shared library.
+    // Files 'src/main.cpp' does not reach are left out with `config{prune_unreachable}`, but for `unreachable_sources_to_compile`.
+    void compile_project(const bool compile_as_dependency = false, const bool position_independent = false, const std::set<std::string>& unreachable_sources_to_compile = {});
     void clear_build();
 
     void build_project();
 
-    void run_unit_tests();
+    void run_unit_tests(const bool track_allocations = false);
+    void run_benchmarks(const std::optional<std::string>& baseline_to_compare = std::nullopt, const std::optional<std::string>& baseline_to_save = std::nullopt, const double threshold = 0.05, const bool collect_hardware_counters = false, const bool track_allocations = false);
+
+    // Recompiles whatever changes under 'headers/', 'src/' and 'tests/' until interrupted, then also links
+    // ("build") or runs the affected unit tests ("test")
+    void watch(const std::string& action);
+
+    // The daemon keeps the dependency graphs and file snapshot of the workspace warm between invocations
+    void start_daemon();
+    void stop_daemon();
+
+    void analyse_build(const unsigned int jobs);
+    void explain_rebuild(const std::string& file_name);
+    void show_impact(const std::string& file_name, const unsigned int jobs);
 
     void perform_static_analysis();
     
@@ -4,6 +4,7 @@
 #include "workspace/project_config.hpp"
 
 #include <filesystem>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -16,17 +17,49 @@ namespace gnu_toolchain {
 
     const std::string SEPARATOR{ std::filesystem::path::preferred_separator };
 
+    #if defined(_WIN32) || defined(_WIN64)
+    const string DISCARD_OUTPUT{ " > NUL 2>&1" };
+    #else
+    const string DISCARD_OUTPUT{ " > /dev/null 2>&1" };
+    #endif
+
     int generate_makefile(const workspace::project_config::Project& project, const string& files, const bool compile_as_dependency = false);
 
-    string get_compilation_command(const workspace::project_config::Project& project, const bool compile_as_dependency = false);
-    int compile_file(const workspace::project_config::Project& project, const string& input_file, const string& output_file, const bool compile_as_dependency = false);
+    string get_compilation_command(const workspace::project_config::Project& project, const bool compile_as_dependency = false, const std::optional<string>& precompiled_header = std::nullopt, const bool position_independent = false);
+    string get_file_compilation_command(const workspace::project_config::Project& project, const string& input_file, const string& output_file, const bool compile_as_dependency = false, const std::optional<string>& precompiled_header = std::nullopt, const bool position_independent = false);
+    int compile_file(const workspace::project_config::Project& project, const string& input_file, const string& output_file, const bool compile_as_dependency = false, const std::optional<string>& precompiled_header = std::nullopt, const bool position_independent = false);
+    string get_module_unit_compilation_command(const workspace::project_config::Project& project, const string& input_file, const string& output_file, const string& module_mapper, const bool compile_as_dependency = false, const bool position_independent = false);
+    string get_batch_compilation_command(const workspace::project_config::Project& project, const string& batch_file, const string& output_file, const std::optional<string>& precompiled_header = std::nullopt, const bool position_independent = false);
+    int precompile_header(const workspace::project_config::Project& project, const string& header, const string& output_file, const string& dependency_file, const bool compile_as_dependency = false, const bool position_independent = false);
+
+    // `-fuse-ld` for the linker of `config{linker}` along with its threading options, empty for the compiler's default
+    string get_linker_flags(const workspace::project_config::Project& project);
+    // `get_linker_flags()` without the threading options, which depend on the machine rather than on what is linked
+    string get_linker_signature(const workspace::project_config::Project& project);
+    int probe_linker(const string& linker);
+    // Version and target of the compiler, one per line
+    int write_toolchain_identity(const string& output_file);
 
-    int perform_linking(const workspace::project_config::Project& project, const std::vector<string>& directories_containing_binaries, const string& executable_file, const bool echo = true);
+    // `discard_output` silences the linker's diagnostics, e.g. for links expected to fail
+    int perform_linking(const workspace::project_config::Project& project, const std::vector<string>& directories_containing_binaries, const string& executable_file, const bool echo = true, const bool discard_output = false);
+    int perform_linking_of_objects(const workspace::project_config::Project& project, const std::vector<string>& objects, const string& executable_file, const bool echo = true, const bool discard_output = false);
+    // Combines `objects` into a single one for a later link to take instead (`ld -r`)
+    int create_relocatable_object(const std::vector<string>& objects, const string& output_file);
 
-    string get_test_execution_command(const workspace::project_config::Project& project, const string& extension);
-    int create_test_binary(const workspace::project_config::Project& project, const std::vector<string>& files_to_link, const string& test_binary);
+    string get_test_execution_command(const workspace::project_config::Project& project, const string& extension, const bool track_allocations = false, const std::optional<string>& test_runtime_header = std::nullopt);
+    int precompile_test_runtime_header(const workspace::project_config::Project& project, const string& header, const string& output_file, const string& dependency_file, const bool track_allocations = false, const bool position_independent = false);
+    int compile_test_runtime(const workspace::project_config::Project& project, const string& source_file, const string& output_file, const string& dependency_file, const bool track_allocations = false, const bool position_independent = false);
+    // `library_directory` is where shared libraries among `files_to_link` are found at runtime, relative to the test binary
+    int create_test_binary(const workspace::project_config::Project& project, const std::vector<string>& files_to_link, const string& test_binary, const bool track_allocations = false, const std::optional<string>& test_runtime_header = std::nullopt, const std::optional<string>& library_directory = std::nullopt);
+    int create_shared_library(const workspace::project_config::Project& project, const std::vector<string>& objects, const std::vector<string>& libraries, const string& library);
+    string get_test_shared_object_command(const workspace::project_config::Project& project, const string& entry_point_header, const bool track_allocations = false, const std::optional<string>& test_runtime_header = std::nullopt);
+    int create_test_shared_object(const workspace::project_config::Project& project, const string& test_file, const string& shared_object, const string& entry_point_header, const bool track_allocations = false, const std::optional<string>& test_runtime_header = std::nullopt);
+    int create_test_runner(const workspace::project_config::Project& project, const string& runner_source, const std::vector<string>& files_to_link, const string& test_runner, const bool track_allocations = false);
     int execute_test_binary(const string& test_binary);
 
+    string get_benchmark_execution_command(const workspace::project_config::Project& project, const string& extension, const bool track_allocations = false);
+    int create_benchmark_binary(const workspace::project_config::Project& project, const std::vector<string>& files_to_link, const string& benchmark_binary, const bool track_allocations = false);
+
     struct CompilerInfo {
         string name;
         string version;
@@ -0,0 +1,56 @@
+#ifndef WORKSPACE_BENCHMARK_BASELINE
+#define WORKSPACE_BENCHMARK_BASELINE
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace workspace::benchmark_baseline {
+    namespace fs = std::filesystem;
+
+    using std::string;
+
+    const string LATEST_BASELINE{ "latest" };
+
+    struct BenchmarkResult {
+        string title;
+        std::size_t iterations;
+        std::vector<double> samples;
+        // Hardware counters per iteration, in the order reported by the harness
+        std::vector<std::tuple<string, double>> counters;
+    };
+
+    struct BenchmarkRecord {
+        string compiler;
+        string machine;
+        std::vector<BenchmarkResult> results;
+    };
+
+    enum class Verdict {
+        IMPROVED,
+        UNCHANGED,
+        REGRESSED,
+        NOISY,
+        NEW
+    };
+
+    struct Comparison {
+        Verdict verdict;
+        double baseline_median;
+        double current_median;
+        double p_value;
+    };
+
+    BenchmarkRecord parse_harness_output(const fs::path& output_file);
+
+    void persist(const string& baseline, const string& benchmark, const BenchmarkRecord& record);
+    std::optional<BenchmarkRecord> load(const string& baseline, const string& benchmark);
+
+    Comparison compare(const std::optional<BenchmarkResult>& baseline, const BenchmarkResult& current, const double threshold);
+    string verdict_to_string(const Verdict& verdict);
+    string describe_counter_changes(const BenchmarkResult& baseline, const BenchmarkResult& current);
+}
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef WORKSPACE_BUILD_ANALYSIS
+#define WORKSPACE_BUILD_ANALYSIS
+
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "workspace/modification_identifier.hpp"
+
+namespace workspace::build_analysis {
+    using std::string;
+
+    // Step names mapped to their last recorded duration in milliseconds
+    using Durations = std::map<string, std::size_t>;
+
+    const string COMPILE_WALL_TIME{ "compile_wall_time" };
+    const string COMPILE_WORK{ "compile_work" };
+    const string LINK_STEP{ "link" };
+
+    string get_test_compilation_step(const string& test_file);
+    string get_test_execution_step(const string& test_file);
+    // Last duration of compiling `file` without a precompiled header, against which the saving is measured
+    string get_compilation_without_precompiled_header_step(const string& file);
+
+    void record_durations(const Durations& durations);
+    Durations load_durations();
+
+    struct Step {
+        string name;
+        std::size_t duration;
+    };
+
+    struct HeaderCost {
+        string header;
+        std::size_t dependants;
+        std::size_t recompile_time;
+    };
+
+    struct Report {
+        std::vector<Step> critical_path;
+        std::size_t critical_path_length;
+
+        std::size_t compile_work;
+        std::size_t longest_compilation;
+        std::size_t files_without_duration;
+
+        std::optional<double> achieved_parallelism;
+        double theoretical_parallelism;
+
+        unsigned int jobs;
+        std::size_t projected_compile_time;
+        std::size_t link_time;
+
+        std::vector<HeaderCost> costliest_headers;
+    };
+
+    struct Dependant {
+        string name;
+        // Unit tests are rebuilt as whole binaries, implementation files as objects
+        bool is_test_binary;
+        std::optional<std::size_t> duration;
+    };
+
+    struct Impact {
+        std::vector<Dependant> dependants;
+        std::size_t total_rebuild_time;
+        unsigned int jobs;
+        std::size_t projected_rebuild_time;
+    };
+
+    Report analyse(
+        const workspace::modification_identifier::RawDependencyTree& sources,
+        const workspace::modification_identifier::RawDependencyTree& tests,
+        const Durations& compilation_durations,
+        const Durations& step_durations,
+        const unsigned int jobs
+    );
+
+    // What modifying `file` would cost the next `compile-project` and `run-unit-tests`
+    Impact analyse_impact(
+        const string& file,
+        const workspace::modification_identifier::RawDependencyTree& sources,
+        const workspace::modification_identifier::RawDependencyTree& tests,
+        const Durations& compilation_durations,
+        const Durations& step_durations,
+        const unsigned int jobs
+    );
+}
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef WORKSPACE_BUILD_DAEMON
+#define WORKSPACE_BUILD_DAEMON
+
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace workspace::build_daemon {
+    using std::string;
+
+    // Lives under '.internals/', so only the workspace it was started from is ever served
+    const string SOCKET_PATH{ ".internals/tmp/daemon.sock" };
+    const std::chrono::minutes IDLE_TIMEOUT{ 15 };
+
+    // Runs a request, e.g. `{ "compile-project" }`, writing to the standard streams as usual
+    using Handler = std::function<void(const std::vector<string>& arguments)>;
+
+    // Hands `arguments` along with this process' standard output and error over to the daemon of the
+    // current workspace and waits for the outcome, i.e. `EXIT_SUCCESS` or `EXIT_FAILURE`. Returns nothing if
+    // no daemon is listening, in which case the request is to be run in-process.
+    std::optional<int> forward(const std::vector<string>& arguments);
+
+    // Detaches a daemon serving one request at a time through `handler`, with the standard streams of
+    // the client in place of its own; an exception escaping `handler` is reported to the client and fails
+    // the request. It shuts itself down after `IDLE_TIMEOUT` without requests. Returns its process ID.
+    int start(const Handler& handler);
+    // Returns whether a daemon was listening
+    bool stop();
+    bool is_running();
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef WORKSPACE_CPP_MODULES
+#define WORKSPACE_CPP_MODULES
+
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace workspace::cpp_modules {
+    using std::string;
+
+    const string MODULES_PATH{ "build/modules" };
+    const string MODULE_INTERFACE_EXTENSION{ ".cppm" };
+
+    // Module dependencies of a translation unit, as P1689 describes them: partitions are named
+    // 'module:partition', and an implementation unit requires the interface of its module
+    struct Unit {
+        string file;
+        std::optional<string> provided_module;
+        std::vector<string> required_modules;
+    };
+
+    bool is_module_interface(const string& file);
+
+    // Units among `files` declaring or importing a module. Header units are rejected, as GCC can only
+    // build them through a module mapper server.
+    std::vector<Unit> scan(const std::vector<string>& files);
+
+    // Files providing the modules each unit imports, throwing if a module is provided twice, not at all, or
+    // imports form a cycle
+    std::map<string, std::vector<string>> get_providers(const std::vector<Unit>& units);
+
+    // Files importing, directly or not, a module provided by one of `files`
+    std::set<string> list_importers(const std::vector<Unit>& units, const std::set<string>& files);
+
+    // Compiled module interfaces are cached per set of compilation flags, e.g. under
+    // 'build/modules/1f2e3d4c/', as any difference makes the compiler reject them
+    string get_bmi_directory(const string& compilation_command);
+    string get_bmi(const string& bmi_directory, const string& module);
+
+    // Maps every module provided by `units` to its compiled interface for `-fmodule-mapper`, rewriting the
+    // mapper only if it changed. Returns its path.
+    string write_module_mapper(const std::vector<Unit>& units, const string& bmi_directory);
+}
+
+#endif
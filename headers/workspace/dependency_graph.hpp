@@ -0,0 +1,74 @@
+#ifndef WORKSPACE_DEPENDENCY_GRAPH
+#define WORKSPACE_DEPENDENCY_GRAPH
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace workspace::dependency_graph {
+    using std::string;
+
+    using NodeId = std::uint32_t;
+    // One bit per node, indexed by `NodeId`
+    using NodeSet = std::vector<bool>;
+
+    struct PathTable {
+        // A `std::deque` never relocates its elements, so the views keying `ids` stay valid as paths are added
+        // and when the table is moved, while copies key theirs anew
+        std::deque<string> paths;
+        std::unordered_map<std::string_view, NodeId> ids;
+
+        PathTable() = default;
+        PathTable(const PathTable& another_table);
+        PathTable(PathTable&&) = default;
+
+        PathTable& operator=(const PathTable& another_table);
+        PathTable& operator=(PathTable&&) = default;
+    };
+
+    // Compressed sparse row adjacency: the neighbours of `node` are `targets[offsets[node]]` up to
+    // `targets[offsets[node + 1]]`
+    struct Adjacency {
+        std::vector<std::uint32_t> offsets;
+        std::vector<NodeId> targets;
+    };
+
+    struct Graph {
+        PathTable table;
+        // Implementation files, in the order they were added; every other node is a header
+        std::vector<NodeId> translation_units;
+        // Implementation files to every header they include, directly or not, as listed by `g++ -MM`
+        Adjacency includes;
+        // Transpose of `includes`: headers to the implementation files including them
+        Adjacency dependants;
+    };
+
+    struct Builder {
+        PathTable table;
+        std::vector<NodeId> translation_units;
+        std::vector<std::pair<NodeId, NodeId>> edges;
+    };
+
+    NodeId intern(PathTable& table, const std::string_view path);
+    std::optional<NodeId> find(const PathTable& table, const std::string_view path);
+
+    NodeId add_translation_unit(Builder& builder, const std::string_view file);
+    void add_include(Builder& builder, const NodeId file, const std::string_view header);
+    Graph build(Builder&& builder);
+
+    std::size_t size(const Graph& graph);
+    const string& get_path(const Graph& graph, const NodeId node);
+    std::span<const NodeId> get_neighbours(const Adjacency& adjacency, const NodeId node);
+
+    // Every node reachable from `dirty` by following `dependants`, `dirty` included
+    NodeSet propagate_dirty(const Graph& graph, NodeSet dirty);
+}
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef WORKSPACE_FILE_SNAPSHOT
+#define WORKSPACE_FILE_SNAPSHOT
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace workspace::file_snapshot {
+    namespace fs = std::filesystem;
+
+    using std::string;
+
+    struct Entry {
+        bool is_directory;
+        bool is_symlink;
+        // Milliseconds since the epoch of `std::filesystem::file_time_type`
+        std::size_t last_modified_timestamp;
+    };
+
+    // The first query below 'headers/', 'src/', 'tests/', 'build/' or 'dependencies/' walks that directory
+    // on several threads, and every later query under it is answered from memory. Paths elsewhere, or below a
+    // symbolic link, are looked up on the filesystem as usual. Snapshots are kept per working directory, so
+    // dependencies compiled from their own root get their own.
+    std::optional<Entry> lookup(const fs::path& path);
+
+    // Whether `path` was recorded while walking and neither it nor any directory above it is a symbolic
+    // link, in which case its canonical form is its lexical one
+    bool is_free_of_symlinks(const fs::path& path);
+
+    bool exists(const fs::path& path);
+    bool is_directory(const fs::path& path);
+    // Throws `std::filesystem::filesystem_error` for missing files, as `std::filesystem::last_write_time` does
+    std::size_t get_last_modified_timestamp(const fs::path& path);
+
+    // Entries directly under `directory`, as generic relative paths in lexicographic order
+    std::vector<string> list_directory(const fs::path& directory);
+    std::vector<string> list_directory_recursively(const fs::path& directory);
+
+    // Forgets what was recorded under the top-level directory holding `path` (e.g. 'build/binaries') after cbt
+    // wrote there, so the next query walks it again
+    void invalidate(const string& path);
+}
+
+#endif
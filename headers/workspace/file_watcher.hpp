@@ -0,0 +1,24 @@
+#ifndef WORKSPACE_FILE_WATCHER
+#define WORKSPACE_FILE_WATCHER
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace workspace::file_watcher {
+    using std::string;
+
+    // Blocks until a C or C++ source, a header or 'project.cfg' under `paths` (directories are watched
+    // recursively) is created, modified, moved or deleted, then keeps collecting changes until none arrives
+    // for `quiet_period`, so a burst of saves yields a single batch. Paths are returned as given, joined with
+    // the relative path of the changed file, e.g. 'src/a/b.cpp'.
+    //
+    // Uses inotify on Linux and compares modification times every `quiet_period` elsewhere.
+    std::vector<string> wait_for_changes(const std::vector<string>& paths, const std::chrono::milliseconds quiet_period);
+
+    // Same as above without blocking: the changes since the previous call, none on the first one, which
+    // starts watching
+    std::vector<string> poll_changes(const std::vector<string>& paths);
+}
+
+#endif
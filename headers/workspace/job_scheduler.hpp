@@ -0,0 +1,48 @@
+#ifndef WORKSPACE_JOB_SCHEDULER
+#define WORKSPACE_JOB_SCHEDULER
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace workspace::job_scheduler {
+    using std::string;
+
+    struct Job {
+        // Names the job in traces, e.g. the file being compiled
+        string label;
+        string command;
+        // Predicted peak resident memory in bytes, `0` if unknown
+        std::size_t expected_memory;
+        // Jobs that have to succeed before this one starts, e.g. those producing the modules it imports
+        std::vector<std::size_t> prerequisites;
+    };
+
+    struct Limits {
+        unsigned int parallelism;
+        // In bytes, `0` for no limit
+        std::size_t memory_budget;
+    };
+
+    struct Outcome {
+        int exit_code;
+        // Peak resident memory in bytes of the job and its children, `0` where unsupported
+        std::size_t peak_memory;
+        // Not run as a prerequisite failed
+        bool was_skipped;
+    };
+
+    using OnStart = std::function<void(const std::size_t job)>;
+    using OnCompletion = std::function<void(const std::size_t job, const Outcome& outcome)>;
+
+    unsigned int get_default_parallelism();
+
+    // Starts `jobs` in the given order, each once its prerequisites succeeded, while both the number of jobs
+    // in flight and the sum of their expected memory stay within `limits`. A job is always admitted when
+    // nothing else is running, so one exceeding the budget on its own still runs, just alone. Jobs whose
+    // prerequisites failed are reported as skipped. Callbacks are invoked on the calling thread.
+    void run(const std::vector<Job>& jobs, const Limits& limits, const OnStart& on_start, const OnCompletion& on_completion);
+}
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef WORKSPACE_JOBSERVER
+#define WORKSPACE_JOBSERVER
+
+#include <chrono>
+#include <optional>
+#include <tuple>
+
+namespace workspace::jobserver {
+    enum class Role {
+        // Tokens come from an outer `make` advertising a jobserver in `MAKEFLAGS`
+        CLIENT,
+        // cbt owns the token pool and advertises it in `MAKEFLAGS` to every process it spawns
+        SERVER,
+        // An outer `make` advertised a jobserver that was not passed down, so jobs run one at a time
+        UNAVAILABLE
+    };
+
+    // Joins the jobserver advertised in `MAKEFLAGS`, otherwise creates one with `slots` slots. Only the
+    // first call has an effect, so nested builds share the same pool.
+    Role initialise(const unsigned int slots);
+
+    // Every process implicitly owns one slot; a token must be acquired for each additional job.
+    bool try_acquire();
+    void release();
+    void wait_for_token(const std::chrono::milliseconds timeout);
+
+    // The pipe advertised in `MAKEFLAGS` as '--jobserver-auth=R,W', provided this process inherited it, for the
+    // daemon to be handed along with a request
+    std::optional<std::tuple<int, int>> find_advertised_pipe();
+    // Advertises the pipe in `MAKEFLAGS` under the descriptors the daemon received it as, `-1` marking it as
+    // not passed down
+    void readvertise_pipe(const int read_end, const int write_end);
+    // Closes the jobserver joined or created by `initialise`, so that the next call follows `MAKEFLAGS` anew
+    void reset();
+}
+
+#endif
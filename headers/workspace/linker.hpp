@@ -0,0 +1,49 @@
+#ifndef WORKSPACE_LINKER
+#define WORKSPACE_LINKER
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "workspace/project_config.hpp"
+
+namespace workspace::linker {
+    using std::string;
+
+    // Choice of `config{linker}=auto`, one line per toolchain
+    const string LINKER_CHOICES_PATH{ ".internals/linkers.txt" };
+    // Linkers `-fuse-ld` knows of, from the usually fastest to the usually slowest
+    const std::vector<string> CANDIDATES{ "mold", "lld", "gold", "bfd" };
+
+    struct Timing {
+        string linker;
+        // In milliseconds, nothing if the link failed
+        std::optional<std::size_t> link_time;
+    };
+
+    struct Benchmark {
+        string choice;
+        std::vector<Timing> timings;
+    };
+
+    // Either `auto`, `default` or one of `CANDIDATES`
+    bool is_valid(const string& linker);
+
+    // Candidates the compiler can actually link with
+    std::vector<string> detect();
+
+    // Linker to pass to `-fuse-ld`, nothing for the compiler's default. With `auto`, the choice recorded for the
+    // current toolchain, if any.
+    std::optional<string> get_linker(const workspace::project_config::Project& project);
+
+    bool needs_benchmark(const workspace::project_config::Project& project);
+
+    // Times `link` once per detected candidate, with `config{linker}` of the project it receives set to that
+    // candidate, and records the fastest for the current toolchain. Falls back to the first detected candidate
+    // when every link fails.
+    Benchmark benchmark(const workspace::project_config::Project& project, const std::function<int(const workspace::project_config::Project&)>& link);
+}
+
+#endif
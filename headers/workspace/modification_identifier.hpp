@@ -3,7 +3,7 @@
 
 #include <filesystem>
 #include <map>
-#include <set>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -26,18 +26,44 @@ namespace workspace::modification_identifier {
         mutable bool affected;
         mutable bool was_successful;
 
-        bool operator<(const SourceFile& another_file) const {
-            return this->hash < another_file.hash;
-        }
+        // Peak resident memory in bytes of the last compilation, `0` if unknown
+        mutable std::size_t peak_memory;
     };
 
-    using SourceFiles = std::set<SourceFile>;
+    // One entry per file of the dependency graph, so distinct paths are never merged even if their hashes collide
+    using SourceFiles = std::vector<SourceFile>;
     using RawDependencyTree = std::map<std::string, std::vector<std::string>>;
 
+    struct RebuildReason {
+        std::string description;
+        // From the file being rebuilt down to the changed input, empty when the reason is the file itself
+        std::vector<std::string> include_chain;
+    };
+
     std::size_t get_current_fileclock_timestamp();
     SourceFiles list_all_files_annotated(const workspace::project_config::Project& project, const bool compile_as_dependency = false);
+
+    // Dirty implementation files in compilation order: those that failed last time or were edited since are
+    // compiled first for quick feedback, then the longest recorded compilations so they don't trail the build
+    std::vector<const SourceFile*> prioritise_for_compilation(const SourceFiles& bucket);
     RawDependencyTree get_files_to_test(const workspace::project_config::Project& project);
+    RawDependencyTree get_benchmarks(const workspace::project_config::Project& project);
     void persist_annotations(const SourceFiles& bucket);
+
+    // Graphs of the last scan of `path` (e.g. 'src', 'tests/unit_tests'), so queries need not re-run `g++ -MM`
+    std::optional<RawDependencyTree> load_dependency_graph(const std::string& path);
+    // Last recorded compilation duration in milliseconds of every implementation file under 'src/'
+    std::map<std::string, std::size_t> get_recorded_compilation_durations();
+    // Watch mode: graphs scanned from now on stay in memory, and later scans of the same directory only run
+    // `g++ -MM` on the files reported changed, the files including them and new implementation files
+    void keep_graphs_resident();
+    void notify_changes(const std::vector<std::string>& changed_files);
+    // Forces the next scans to start over, e.g. after 'project.cfg' changed include paths or dependencies
+    void discard_resident_graphs();
+
+    // Why the next build would recompile `file` (an implementation or unit test file) according to the recorded
+    // graphs, `std::nullopt` if the last build did not know the file and an empty list if it is up-to-date
+    std::optional<std::vector<RebuildReason>> explain_rebuild(const workspace::project_config::Project& project, const std::string& file);
 }
 
 #endif
@@ -0,0 +1,30 @@
+#ifndef WORKSPACE_PARTIAL_LINK
+#define WORKSPACE_PARTIAL_LINK
+
+#include <set>
+#include <string>
+#include <vector>
+
+namespace workspace::partial_link {
+    using std::string;
+
+    const string PARTIAL_LINK_PATH{ "build/partial_links" };
+
+    struct Group {
+        // Relocatable object the members are combined into, e.g. 'build/partial_links/binaries/cbt_tools.o'
+        string object;
+        std::vector<string> members;
+        // Lists `members`, rewritten only when they change so that a removed member triggers a relink as well
+        string manifest;
+    };
+
+    // One group per directory of `directories_containing_binaries`, except for those under 'build/dependencies/'
+    // which are grouped per dependency. Directories holding a single object are left out, as combining it
+    // would save the final link nothing. Objects of `excluded_objects` belong to no group.
+    std::vector<Group> plan(const std::vector<string>& directories_containing_binaries, const std::set<string>& excluded_objects = {});
+
+    // Objects of `directories_containing_binaries` neither a group covers nor `excluded_objects` lists
+    std::vector<string> list_ungrouped_objects(const std::vector<string>& directories_containing_binaries, const std::vector<Group>& groups, const std::set<string>& excluded_objects = {});
+}
+
+#endif
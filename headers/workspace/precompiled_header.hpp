@@ -0,0 +1,52 @@
+#ifndef WORKSPACE_PRECOMPILED_HEADER
+#define WORKSPACE_PRECOMPILED_HEADER
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "workspace/modification_identifier.hpp"
+#include "workspace/project_config.hpp"
+
+namespace workspace::precompiled_header {
+    using std::string;
+
+    const string PRECOMPILED_HEADERS_PATH{ "build/pch" };
+
+    // A header has to be included by at least this share of the C++ implementation files, and by two of them,
+    // to be worth parsing ahead of every compilation
+    const double MINIMUM_SHARE{ 0.5 };
+
+    struct Selection {
+        // Standard library headers included directly by the files or their project headers, e.g. 'vector'
+        std::vector<string> standard_headers;
+        // Project and dependency headers as recorded in the dependency graph, e.g. 'headers/a.hpp'
+        std::vector<string> project_headers;
+    };
+
+    struct PrecompiledHeader {
+        // To be passed with `-include`, the compiler picking up the '.gch' next to it
+        string header;
+        std::size_t header_count;
+
+        bool was_rebuilt;
+        bool was_successful;
+        // In milliseconds, `0` unless rebuilt
+        std::size_t build_time;
+    };
+
+    Selection select_headers(const workspace::modification_identifier::RawDependencyTree& sources);
+
+    // Every C++ implementation file compiled with the precompiled header parses the selected headers, whether
+    // it includes them or not, yet `g++ -MM` only relates it to those it does. Marks all of them affected as
+    // soon as one of the selected project headers is.
+    void mark_dependants_affected(const Selection& selection, const workspace::modification_identifier::SourceFiles& files);
+
+    // Reuses the precompiled header built for the same selection and compilation flags, unless one of the
+    // headers it contains changed since, otherwise builds it. Each set of flags gets its own directory, so
+    // switching between them does not rebuild anything. Returns nothing if no header was selected.
+    std::optional<PrecompiledHeader> prepare(const workspace::project_config::Project& project, const Selection& selection, const bool compile_as_dependency = false, const bool position_independent = false);
+}
+
+#endif
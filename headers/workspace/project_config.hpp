@@ -1,6 +1,7 @@
 #ifndef WORKSPACE_PROJECT_CONFIG
 #define WORKSPACE_PROJECT_CONFIG
 
+#include <cstddef>
 #include <map>
 #include <optional>
 #include <set>
@@ -28,6 +29,28 @@ namespace workspace::project_config {
         string compile_time_flags;
         string build_flags;
         string test_flags;
+        // Memory budget for parallel compilations, e.g. `8G`
+        std::optional<string> max_memory;
+        // Precompile the headers most implementation files include and inject them into every C++ compilation
+        std::optional<bool> precompiled_header;
+        // Compile 'src/' in batches of files sharing the most includes (`on`/`off` in 'project.cfg')
+        std::optional<bool> unity;
+        std::optional<std::size_t> unity_batch_size;
+        // `executables` builds one binary per unit test file, `aggregated` loads them all into a single runner
+        // process, and `isolated` does too but forks that process for each of them
+        std::optional<string> unit_test_runner;
+        // Link unit test executables against 'libproject.so' and a library per dependency rather than their objects
+        std::optional<bool> shared_test_libraries;
+        // Keep the debug info of objects in '.dwo' files next to them, out of what the linker has to copy
+        std::optional<bool> split_dwarf;
+        // Link with `--gdb-index`, so that debuggers need not scan the debug info on startup
+        std::optional<bool> gdb_index;
+        // `auto` benchmarks the available linkers once per toolchain, `default` leaves the choice to the compiler
+        std::optional<string> linker;
+        // Combine the objects of each directory, and of each dependency, into one before the final link
+        std::optional<bool> partial_link;
+        // Link only the files 'src/main.cpp' reaches through headers and the sources paired with them
+        std::optional<bool> prune_unreachable;
     };
 
     struct Cppcheck {
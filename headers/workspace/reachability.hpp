@@ -0,0 +1,25 @@
+#ifndef WORKSPACE_REACHABILITY
+#define WORKSPACE_REACHABILITY
+
+#include <optional>
+#include <set>
+#include <string>
+
+#include "workspace/modification_identifier.hpp"
+
+namespace workspace::reachability {
+    using std::string;
+
+    const string ENTRY_POINT{ "src/main.cpp" };
+
+    // Implementation file mirroring `header`, e.g. 'src/a/b.cpp' for 'headers/a/b.hpp' and 'src/c/d.c' for
+    // 'headers/c/d.h'. Nothing for headers outside 'headers/', such as those of dependencies.
+    std::optional<string> get_paired_source(const string& header);
+
+    // Implementation files of `graph` (as `load_dependency_graph("src")` returns it) that `ENTRY_POINT` reaches
+    // by including the header of one, which in turn reaches those it includes the headers of. Nothing if the
+    // graph lacks `ENTRY_POINT`, e.g. for a library.
+    std::optional<std::set<string>> find_reachable_sources(const workspace::modification_identifier::RawDependencyTree& graph);
+}
+
+#endif
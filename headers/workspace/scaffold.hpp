@@ -14,6 +14,7 @@ namespace workspace::scaffold {
     bool create_directory(const string& project_name, const string& sub_directory = "", const bool multi_directory = false, const bool verbose = true);
     
     void create_working_tree_as_necessary();
+    void create_missing_tool_headers(const workspace::project_config::Project& project);
 
     void purge_old_binaries(const string& path, const workspace::modification_identifier::SourceFiles& annotated_files);
 
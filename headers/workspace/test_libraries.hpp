@@ -0,0 +1,29 @@
+#ifndef WORKSPACE_TEST_LIBRARIES
+#define WORKSPACE_TEST_LIBRARIES
+
+#include <string>
+#include <vector>
+
+namespace workspace::test_libraries {
+    using std::string;
+
+    const string TEST_LIBRARIES_PATH{ "build/test_binaries" };
+
+    struct Library {
+        // E.g. 'build/test_binaries/libproject.so', also recorded as its soname without the directory
+        string file;
+        std::vector<string> objects;
+        // Other libraries of the plan it links against
+        std::vector<string> libraries;
+        // Lists `objects`, rewritten only when they change so that a removed object triggers a relink as well
+        string manifest;
+    };
+
+    // One library per dependency under 'build/dependencies/', followed by 'libproject.so' holding the objects of
+    // the project except the one of 'src/main.cpp', which links against all of them
+    std::vector<Library> plan();
+
+    bool is_supported();
+}
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef WORKSPACE_TEST_RUNNER
+#define WORKSPACE_TEST_RUNNER
+
+#include <string>
+#include <vector>
+
+#include "workspace/project_config.hpp"
+
+namespace workspace::test_runner {
+    using std::string;
+
+    const string TEST_RUNNER_PATH{ "build/test_runner" };
+    // Name under which the `main()` of every unit test is compiled into its shared object
+    const string ENTRY_POINT{ "cbt_unit_test_main" };
+
+    enum class Mode {
+        EXECUTABLES,
+        AGGREGATED,
+        ISOLATED
+    };
+
+    Mode get_mode(const workspace::project_config::Project& project);
+
+    // Loading shared objects relies on `dlopen()`, hence POSIX only
+    bool is_supported();
+
+    // Writes the header to force-include into every test so that its `main()` becomes `ENTRY_POINT`. Returns
+    // its path.
+    string write_entry_point_header();
+
+    // Writes the source of the runner, which loads every shared object given on its command line and calls
+    // its entry point, in a child process each with `--isolate`. Returns its path.
+    string write_source();
+
+    // Objects of the project except the one of 'src/main.cpp', of its dependencies and of unity batches, i.e.
+    // everything a test may reference
+    std::vector<string> list_objects();
+
+    // Lists `objects` in a manifest rewritten only when they change, so that removing an object is noticed
+    // by comparing timestamps just like adding one. Returns its path.
+    string write_manifest(const std::vector<string>& objects);
+}
+
+#endif
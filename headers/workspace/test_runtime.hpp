@@ -0,0 +1,34 @@
+#ifndef WORKSPACE_TEST_RUNTIME
+#define WORKSPACE_TEST_RUNTIME
+
+#include <cstddef>
+#include <optional>
+#include <string>
+
+#include "workspace/project_config.hpp"
+
+namespace workspace::test_runtime {
+    using std::string;
+
+    const string TEST_RUNTIME_PATH{ "build/test_runtime" };
+
+    struct TestRuntime {
+        // Precompiled 'cbt_tools/test_harness.hpp' along with its standard includes, to be passed with `-include`
+        string header;
+        // Allocation hooks of 'cbt_tools/alloc_tracker.hpp', only when tracking allocations with a project whose
+        // copy of the header lets them be compiled apart from the test
+        std::optional<string> object;
+
+        bool was_rebuilt;
+        bool was_successful;
+        // In milliseconds, `0` unless rebuilt
+        std::size_t build_time;
+    };
+
+    // Reuses the runtime built for the same test flags, unless the harness or a header it includes changed
+    // since, otherwise builds it. Tests compiled into shared objects need it `position_independent`. Returns
+    // nothing if the project has no test harness.
+    std::optional<TestRuntime> prepare(const workspace::project_config::Project& project, const bool track_allocations = false, const bool position_independent = false);
+}
+
+#endif
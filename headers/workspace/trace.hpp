@@ -0,0 +1,46 @@
+#ifndef WORKSPACE_TRACE
+#define WORKSPACE_TRACE
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace workspace::trace {
+    using std::string;
+
+    using Clock = std::chrono::steady_clock;
+    using Arguments = std::vector<std::pair<string, string>>;
+
+    const string OUTPUT_VARIABLE{ "CBT_TRACE" };
+
+    // Tracing is enabled by pointing `CBT_TRACE` at a file, which receives a Chrome trace-event JSON
+    // (viewable in `chrome://tracing` or Perfetto) when cbt exits
+    bool is_enabled();
+
+    // Discards whatever was recorded and starts over according to the current `CBT_TRACE`, e.g. once per
+    // request a daemon serves
+    void restart();
+
+    // Writes out what was recorded so far and stops recording, so that nothing is written again at exit
+    void finish();
+
+    // Lane `0` is cbt itself, lane `n + 1` is job slot `n` of the scheduler
+    void record(const string& name, const string& category, const Clock::time_point start, const Clock::time_point end, const unsigned int lane, const Arguments& arguments = {});
+
+    class Span {
+    public:
+        explicit Span(const string& name, const Arguments& arguments = {});
+        ~Span();
+
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+
+    private:
+        const string name;
+        const Arguments arguments;
+        const Clock::time_point start;
+    };
+}
+
+#endif
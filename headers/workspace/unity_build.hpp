@@ -0,0 +1,61 @@
+#ifndef WORKSPACE_UNITY_BUILD
+#define WORKSPACE_UNITY_BUILD
+
+#include <cstddef>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "workspace/modification_identifier.hpp"
+
+namespace workspace::unity_build {
+    using std::string;
+
+    const string UNITY_PATH{ "build/unity" };
+    const std::size_t DEFAULT_BATCH_SIZE{ 8 };
+
+    struct Batch {
+        // e.g. 'build/unity/batch_3.cpp', compiled to 'build/unity/batch_3.o'
+        string file;
+        std::vector<string> members;
+
+        bool needs_compilation;
+    };
+
+    struct Plan {
+        std::vector<Batch> batches;
+        // Compiled on their own, e.g. files edited since the batches were formed
+        std::vector<string> loose_files;
+    };
+
+    // Files defining the same name with internal linkage (in an anonymous namespace, `static` or a macro),
+    // which would clash if they shared a batch
+    struct Collision {
+        string name;
+        std::vector<string> files;
+    };
+
+    // Batches `candidates` (C++ implementation files under 'src/') by shared includes according to `sources`
+    // when most of them are dirty, e.g. on a clean build. Otherwise keeps the batches of the last plan and
+    // takes the dirty files out of them, so edits only ever recompile the edited file on its own (plus, the
+    // first time, its former batch). Collisions are reported when batches are formed.
+    Plan plan(const workspace::modification_identifier::RawDependencyTree& sources, const std::vector<string>& candidates, const std::set<string>& dirty_files, const std::size_t batch_size, std::vector<Collision>& collisions);
+
+    // Writes the batch files whose membership changed, removes stale batches and the objects of files now
+    // compiled within a batch, then records the plan
+    void apply(const Plan& plan);
+
+    // Returns the files that were batched, which need their own objects again, and removes every batch
+    std::vector<string> discard();
+
+    string get_object(const Batch& batch);
+
+    // Loose files of `plan` lacking an object of their own, which `apply()` removed while they were batched,
+    // e.g. the member left over when its batch shrank to a single file. They need compiling even if clean.
+    std::vector<string> list_loose_files_without_object(const Plan& plan);
+
+    // Whether `file` is compiled within a batch according to the last plan applied
+    bool is_batched(const string& file);
+}
+
+#endif
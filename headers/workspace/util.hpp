@@ -2,7 +2,9 @@
 #define WORKSPACE_UTIL
 
 #include <chrono>
+#include <cstddef>
 #include <filesystem>
+#include <optional>
 #include <string>
 #include <tuple>
 
@@ -33,6 +35,14 @@ namespace workspace::util {
 
     string get_ISO_date();
     std::chrono::year_month_day parse_date(const string& iso_date);
+
+    string get_machine_identity();
+    void set_env(const string& key, const string& value);
+
+    // Accepts plain bytes or a binary `K`, `M`, `G` or `T` suffix, e.g. `512M` or `8G`
+    std::optional<std::size_t> parse_memory_size(const string& text);
+    // In bytes, `0` if unknown
+    std::size_t get_available_memory();
 }
 
 #endif
@@ -5,8 +5,8 @@ readonly HEADERS_DIR="headers"
 readonly BUILD_DIR="build"
 readonly BINARIES_DIR="$BUILD_DIR/binaries"
 
-readonly COMPILE_FLAGS="-std=$CPP_STANDARD $SAFETY_FLAGS -Os -s -c -I$HEADERS_DIR/"
-readonly BUILD_FLAGS="-std=$CPP_STANDARD $SAFETY_FLAGS -O3 -s"
+readonly COMPILE_FLAGS="-std=$CPP_STANDARD $SAFETY_FLAGS -pthread -Os -s -c -I$HEADERS_DIR/"
+readonly BUILD_FLAGS="-std=$CPP_STANDARD $SAFETY_FLAGS -pthread -O3 -s"
 
 function init() {
     echo "==========="
@@ -23,11 +23,29 @@ function compile() {
     echo "=============="
     echo
     echo "[COMPILE] src/gnu_toolchain.cpp" && g++ $COMPILE_FLAGS src/gnu_toolchain.cpp -o $BINARIES_DIR/gnu_toolchain.o
+    echo "[COMPILE] src/workspace/benchmark_baseline.cpp" && g++ $COMPILE_FLAGS src/workspace/benchmark_baseline.cpp -o $BINARIES_DIR/workspace/benchmark_baseline.o
+    echo "[COMPILE] src/workspace/build_analysis.cpp" && g++ $COMPILE_FLAGS src/workspace/build_analysis.cpp -o $BINARIES_DIR/workspace/build_analysis.o
+    echo "[COMPILE] src/workspace/build_daemon.cpp" && g++ $COMPILE_FLAGS src/workspace/build_daemon.cpp -o $BINARIES_DIR/workspace/build_daemon.o
+    echo "[COMPILE] src/workspace/cpp_modules.cpp" && g++ $COMPILE_FLAGS src/workspace/cpp_modules.cpp -o $BINARIES_DIR/workspace/cpp_modules.o
     echo "[COMPILE] src/workspace/dependencies_manager.cpp" && g++ $COMPILE_FLAGS src/workspace/dependencies_manager.cpp -o $BINARIES_DIR/workspace/dependencies_manager.o
+    echo "[COMPILE] src/workspace/dependency_graph.cpp" && g++ $COMPILE_FLAGS src/workspace/dependency_graph.cpp -o $BINARIES_DIR/workspace/dependency_graph.o
     echo "[COMPILE] src/workspace/env_manager.cpp" && g++ $COMPILE_FLAGS src/workspace/env_manager.cpp -o $BINARIES_DIR/workspace/env_manager.o
+    echo "[COMPILE] src/workspace/file_snapshot.cpp" && g++ $COMPILE_FLAGS src/workspace/file_snapshot.cpp -o $BINARIES_DIR/workspace/file_snapshot.o
+    echo "[COMPILE] src/workspace/file_watcher.cpp" && g++ $COMPILE_FLAGS src/workspace/file_watcher.cpp -o $BINARIES_DIR/workspace/file_watcher.o
+    echo "[COMPILE] src/workspace/job_scheduler.cpp" && g++ $COMPILE_FLAGS src/workspace/job_scheduler.cpp -o $BINARIES_DIR/workspace/job_scheduler.o
+    echo "[COMPILE] src/workspace/jobserver.cpp" && g++ $COMPILE_FLAGS src/workspace/jobserver.cpp -o $BINARIES_DIR/workspace/jobserver.o
+    echo "[COMPILE] src/workspace/linker.cpp" && g++ $COMPILE_FLAGS src/workspace/linker.cpp -o $BINARIES_DIR/workspace/linker.o
     echo "[COMPILE] src/workspace/modification_identifier.cpp" && g++ $COMPILE_FLAGS src/workspace/modification_identifier.cpp -o $BINARIES_DIR/workspace/modification_identifier.o
+    echo "[COMPILE] src/workspace/partial_link.cpp" && g++ $COMPILE_FLAGS src/workspace/partial_link.cpp -o $BINARIES_DIR/workspace/partial_link.o
+    echo "[COMPILE] src/workspace/precompiled_header.cpp" && g++ $COMPILE_FLAGS src/workspace/precompiled_header.cpp -o $BINARIES_DIR/workspace/precompiled_header.o
     echo "[COMPILE] src/workspace/project_config.cpp" && g++ $COMPILE_FLAGS src/workspace/project_config.cpp -o $BINARIES_DIR/workspace/project_config.o
+    echo "[COMPILE] src/workspace/reachability.cpp" && g++ $COMPILE_FLAGS src/workspace/reachability.cpp -o $BINARIES_DIR/workspace/reachability.o
     echo "[COMPILE] src/workspace/scaffold.cpp" && g++ $COMPILE_FLAGS src/workspace/scaffold.cpp -o $BINARIES_DIR/workspace/scaffold.o
+    echo "[COMPILE] src/workspace/test_libraries.cpp" && g++ $COMPILE_FLAGS src/workspace/test_libraries.cpp -o $BINARIES_DIR/workspace/test_libraries.o
+    echo "[COMPILE] src/workspace/test_runner.cpp" && g++ $COMPILE_FLAGS src/workspace/test_runner.cpp -o $BINARIES_DIR/workspace/test_runner.o
+    echo "[COMPILE] src/workspace/test_runtime.cpp" && g++ $COMPILE_FLAGS src/workspace/test_runtime.cpp -o $BINARIES_DIR/workspace/test_runtime.o
+    echo "[COMPILE] src/workspace/trace.cpp" && g++ $COMPILE_FLAGS src/workspace/trace.cpp -o $BINARIES_DIR/workspace/trace.o
+    echo "[COMPILE] src/workspace/unity_build.cpp" && g++ $COMPILE_FLAGS src/workspace/unity_build.cpp -o $BINARIES_DIR/workspace/unity_build.o
     echo "[COMPILE] src/workspace/util.cpp" && g++ $COMPILE_FLAGS src/workspace/util.cpp -o $BINARIES_DIR/workspace/util.o
     echo "[COMPILE] src/commands.cpp" && g++ $COMPILE_FLAGS src/commands.cpp -o $BINARIES_DIR/commands.o
     echo "[COMPILE] src/main.cpp" && g++ $COMPILE_FLAGS src/main.cpp -o $BINARIES_DIR/main.o
@@ -1,18 +1,42 @@
 #include "commands.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <filesystem>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <optional>
 #include <set>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "gnu_toolchain.hpp"
+#include "workspace/benchmark_baseline.hpp"
+#include "workspace/build_analysis.hpp"
+#include "workspace/build_daemon.hpp"
+#include "workspace/cpp_modules.hpp"
 #include "workspace/dependencies_manager.hpp"
+#include "workspace/file_snapshot.hpp"
+#include "workspace/file_watcher.hpp"
+#include "workspace/job_scheduler.hpp"
+#include "workspace/linker.hpp"
 #include "workspace/modification_identifier.hpp"
+#include "workspace/partial_link.hpp"
+#include "workspace/precompiled_header.hpp"
 #include "workspace/project_config.hpp"
+#include "workspace/reachability.hpp"
 #include "workspace/scaffold.hpp"
+#include "workspace/test_libraries.hpp"
+#include "workspace/test_runner.hpp"
+#include "workspace/test_runtime.hpp"
+#include "workspace/trace.hpp"
+#include "workspace/unity_build.hpp"
 #include "workspace/util.hpp"
 
 namespace {
@@ -50,6 +74,7 @@ namespace {
             create_directory(project_name, "build/dependencies");
             create_directory(project_name, "build/test_binaries");
             create_directory(project_name, "build/test_binaries/unit_tests");
+            create_directory(project_name, "build/test_binaries/benchmarks");
             create_directory(project_name, "dependencies");
             create_directory(project_name, "docs");
             create_file(project, "docs/LICENSE.txt");
@@ -63,6 +88,8 @@ namespace {
             create_directory(project_name, "headers/c");
             create_file(project, "headers/c/linkage_demo.h");
             create_directory(project_name, "headers/cbt_tools");
+            create_file(project, "headers/cbt_tools/alloc_tracker.hpp");
+            create_file(project, "headers/cbt_tools/bench_harness.hpp");
             create_file(project, "headers/cbt_tools/env_manager.hpp");
             create_file(project, "headers/cbt_tools/test_harness.hpp");
             create_file(project, "headers/cbt_tools/utils.hpp");
@@ -87,6 +114,8 @@ namespace {
             create_directory(project_name, "tests/unit_tests/c");
             create_file(project, "tests/unit_tests/c/linkage_demo.cpp");
             create_file(project, "tests/unit_tests/sample.cpp");
+            create_directory(project_name, "tests/benchmarks");
+            create_file(project, "tests/benchmarks/sample.cpp");
             create_file(project, "README.md");
             
             create_file(project, "project.cfg");
@@ -98,26 +127,204 @@ namespace {
     }
 
     void list_directories_containing_binaries(std::set<string>& directories_containing_binaries, const string& build_path) {
-        const string BUILD_PATH{ workspace::util::get_platform_formatted_filename(fs::path(build_path)) };
+        std::vector<string> entries{ workspace::file_snapshot::list_directory_recursively(build_path) };
+        entries.insert(entries.begin(), build_path);
 
-        for (auto dir_entry = fs::recursive_directory_iterator("build"); dir_entry != fs::recursive_directory_iterator(); ++dir_entry) {
-            const string normalised_path{ workspace::util::get_platform_formatted_filename(dir_entry->path().string()) };
-
-            if (!normalised_path.starts_with(BUILD_PATH)) {
-                dir_entry.disable_recursion_pending();
-            }
-            
-            if (fs::is_directory(*dir_entry)) {
+        for (const auto& entry: entries) {
+            if (workspace::file_snapshot::is_directory(entry)) {
                 const int files_count = std::ranges::count_if(
-                    fs::directory_iterator(dir_entry->path()),
-                    [](const auto& file){ return file.is_regular_file(); }
+                    workspace::file_snapshot::list_directory(entry),
+                    [](const string& file){ return !workspace::file_snapshot::is_directory(file); }
                 );
 
                 if (files_count != 0) {
-                    directories_containing_binaries.insert(normalised_path);
+                    directories_containing_binaries.insert(workspace::util::get_platform_formatted_filename(entry));
+                }
+            }
+        }
+    }
+
+    std::vector<string> list_files_to_link(const string& file, const std::vector<string>& dependencies, const std::vector<fs::path>& excluded_headers) {
+        const size_t literal_length_of_headers{ std::string("headers/").length() };
+        const size_t literal_length_of_dependencies{ std::string(".internals/dh_symlinks/").length() };
+
+        std::vector<string> files_to_link{ file };
+
+        for (auto const& dependency: dependencies) {
+            const bool is_excluded = std::ranges::any_of(
+                excluded_headers,
+                [&dependency](const auto& excluded_header){ return fs::path(dependency).lexically_normal() == excluded_header.lexically_normal(); }
+            );
+
+            if (!is_excluded) {
+                const bool is_own_dependency{ dependency.starts_with("headers") };
+                const bool is_c_header{ dependency.ends_with(".h") };
+
+                const fs::path corresponding_implementation_file{ (is_own_dependency
+                    ? fs::path("src/" + dependency.substr(literal_length_of_headers))
+                    : fs::path([&dependency](){
+                            const string symlink{ fs::read_symlink(dependency.substr(0, dependency.rfind("/"))).string() };
+
+                            const size_t start{ symlink.rfind("dependencies/") };
+                            const size_t stop{ symlink.rfind("/headers") };
+
+                            const std::string shortened_symlink{ symlink.substr(start, stop - start) };
+
+                            const size_t dep_start{ shortened_symlink.find("/") };
+                            const size_t dep_stop{ shortened_symlink.find("@") };
+
+                            const std::string dependency_name{ shortened_symlink.substr(dep_start + 1, dep_stop - dep_start - 1) };
+
+                            return shortened_symlink + "/src/" + dependency.substr(dependency.find(dependency_name) + dependency_name.length() + 1);
+                        }())
+                    ).replace_extension(is_c_header ? "c" : "cpp")
+                };
+
+                if (workspace::file_snapshot::exists(corresponding_implementation_file)) {
+                    const fs::path corresponding_binary{ (is_own_dependency
+                        ? fs::path("build/binaries/" + dependency.substr(literal_length_of_headers))
+                        : fs::path("build/dependencies/" + dependency.substr(literal_length_of_dependencies))
+                        ).replace_extension("o")
+                    };
+
+                    if (!workspace::file_snapshot::exists(corresponding_binary) && is_own_dependency && workspace::unity_build::is_batched(corresponding_implementation_file.string())) {
+                        // Batched files have no object of their own, and linking their batch would drag its other members along
+                        files_to_link.push_back(corresponding_implementation_file.string());
+                    } else if (!workspace::file_snapshot::exists(corresponding_binary)) {
+                        throw std::runtime_error("Corresponding binary for '" + workspace::util::get_platform_formatted_filename(dependency) + "' not found! Run `cbt " + (is_own_dependency ? "compile-project" : "resolve-dependencies") + "`.");
+                    } else {
+                        files_to_link.push_back(corresponding_binary.string());
+                    }
                 }
             }
         }
+
+        return files_to_link;
+    }
+
+    bool is_binary_outdated(const fs::path& binary, const std::vector<string>& files_to_link, const std::vector<string>& dependencies) {
+        if (!workspace::file_snapshot::exists(binary)) {
+            return true;
+        }
+
+        const std::size_t binary_timestamp{ workspace::file_snapshot::get_last_modified_timestamp(binary) };
+
+        const auto is_newer = [&binary_timestamp](const string& file){ return workspace::file_snapshot::get_last_modified_timestamp(file) > binary_timestamp; };
+
+        return std::ranges::any_of(files_to_link, is_newer) || std::ranges::any_of(dependencies, is_newer);
+    }
+
+    // Markers, i.e. dot files, are left for their owners to update
+    void discard_binaries(const fs::path& directory) {
+        std::vector<fs::path> stale_binaries{};
+
+        for (auto const& entry: fs::recursive_directory_iterator(directory)) {
+            if (entry.is_regular_file() && !entry.path().filename().string().starts_with(".")) {
+                stale_binaries.push_back(entry.path());
+            }
+        }
+
+        for (auto const& binary: stale_binaries) {
+            fs::remove(binary);
+        }
+
+        workspace::file_snapshot::invalidate(directory.string());
+    }
+
+    // Binaries built with and without `--track-allocations` differ, so switching modes discards the stale ones
+    void discard_binaries_if_tracking_changed(const fs::path& directory, const bool track_allocations) {
+        const fs::path marker{ directory / ".allocation_tracking" };
+
+        if (fs::exists(marker) == track_allocations) {
+            return;
+        }
+
+        discard_binaries(directory);
+
+        if (track_allocations) {
+            std::ofstream(marker).close();
+        } else {
+            fs::remove(marker);
+        }
+    }
+
+    // Objects compiled with and without '-fPIC' differ as well, yet their sources are unchanged, so the caller
+    // has to recompile them all when discarded
+    bool discard_binaries_if_position_independence_changed(const fs::path& directory, const bool position_independent) {
+        const fs::path marker{ directory / ".position_independent" };
+
+        if (fs::exists(marker) == position_independent) {
+            return false;
+        }
+
+        discard_binaries(directory);
+
+        if (position_independent) {
+            std::ofstream(marker).close();
+        } else {
+            fs::remove(marker);
+        }
+
+        return true;
+    }
+
+    // Binaries linked by another linker, or with other options for it, are discarded to be relinked
+    void discard_binaries_if_linker_changed(const fs::path& directory, const string& linker_signature) {
+        const fs::path marker{ directory / ".linker" };
+
+        std::ifstream stream(marker);
+        string recorded_linker_signature{};
+        std::getline(stream, recorded_linker_signature);
+        stream.close();
+
+        if (recorded_linker_signature == linker_signature) {
+            return;
+        }
+
+        discard_binaries(directory);
+
+        if (linker_signature.empty()) {
+            fs::remove(marker);
+        } else {
+            std::ofstream(marker) << linker_signature << "\n";
+        }
+    }
+
+    void choose_linker_if_needed(const Project& project, const std::vector<string>& directories_containing_binaries) {
+        if (!workspace::linker::needs_benchmark(project)) {
+            return;
+        }
+
+        const string benchmark_binary{ ".internals/tmp/linker_benchmark" };
+
+        // Candidates failing is expected, e.g. for a library without `main()`, hence their diagnostics are discarded
+        const workspace::linker::Benchmark benchmark{ workspace::linker::benchmark(project, [&](const Project& candidate) {
+            return gnu_toolchain::perform_linking(candidate, directories_containing_binaries, benchmark_binary, false, true);
+        }) };
+
+        fs::remove(benchmark_binary);
+
+        cout << "[INFO] Linker '" << benchmark.choice << "' chosen for this toolchain";
+
+        for (const auto& timing: benchmark.timings) {
+            cout << (&timing == &benchmark.timings.front() ? " (" : ", ") << timing.linker << ": "
+                << (timing.link_time.has_value() ? std::to_string(timing.link_time.value()) + "ms" : "failed")
+                << (&timing == &benchmark.timings.back() ? ")" : "");
+        }
+
+        cout << endl << endl;
+    }
+
+    workspace::job_scheduler::Limits get_compilation_limits(const Project& project) {
+        const std::size_t memory_budget{ project.config.max_memory.has_value()
+            ? workspace::util::parse_memory_size(project.config.max_memory.value()).value_or(0)
+            : workspace::util::get_available_memory() / 4 * 3
+        };
+
+        return workspace::job_scheduler::Limits{
+            .parallelism{ workspace::job_scheduler::get_default_parallelism() },
+            .memory_budget{ memory_budget }
+        };
     }
 
     bool are_dependencies_unresolved(const SurfaceDependencies& dependencies) {
@@ -132,6 +339,344 @@ namespace {
 
         return false;
     }
+
+    struct ModuleBuild {
+        // Files declaring or importing a module, each with the files providing the modules it imports
+        std::map<string, std::vector<string>> providers;
+        string module_mapper;
+    };
+
+    // Marks affected the interfaces whose compiled form is missing and, transitively, every file importing an
+    // affected interface, as the compiler reads imported modules from their compiled form rather than their source
+    std::optional<ModuleBuild> plan_module_build(const Project& project, const workspace::modification_identifier::SourceFiles& annotated_files, const bool compile_as_dependency, const bool position_independent) {
+        std::vector<string> files{};
+
+        for (const auto& file: annotated_files) {
+            if (file.file_name.starts_with("src/") && !file.file_name.starts_with("src/c/") && (file.file_name.ends_with(".cpp") || workspace::cpp_modules::is_module_interface(file.file_name))) {
+                files.push_back(file.file_name);
+            }
+        }
+
+        if (std::ranges::none_of(files, workspace::cpp_modules::is_module_interface)) {
+            return std::nullopt;
+        }
+
+        if (project.config.cpp_standard.compare("c++17") == 0) {
+            throw std::runtime_error("Modules require 'config{cpp_standard}' to be 'c++20' or later (in 'project.cfg')");
+        }
+
+        const std::vector<workspace::cpp_modules::Unit> units{ workspace::cpp_modules::scan(files) };
+        const string bmi_directory{ workspace::cpp_modules::get_bmi_directory(gnu_toolchain::get_compilation_command(project, compile_as_dependency, std::nullopt, position_independent)) };
+
+        std::set<string> affected_interfaces{};
+
+        for (const auto& unit: units) {
+            if (!unit.provided_module.has_value()) {
+                continue;
+            }
+
+            for (const auto& file: annotated_files) {
+                if (file.file_name == unit.file && (file.affected || !fs::exists(workspace::cpp_modules::get_bmi(bmi_directory, unit.provided_module.value())))) {
+                    file.affected = true;
+                    affected_interfaces.insert(unit.file);
+                }
+            }
+        }
+
+        const std::set<string> importers{ workspace::cpp_modules::list_importers(units, affected_interfaces) };
+
+        for (const auto& file: annotated_files) {
+            if (importers.contains(file.file_name)) {
+                file.affected = true;
+            }
+        }
+
+        return ModuleBuild{
+            .providers{ workspace::cpp_modules::get_providers(units) },
+            .module_mapper{ workspace::cpp_modules::write_module_mapper(units, bmi_directory) }
+        };
+    }
+
+    // Implementation files 'src/main.cpp' does not reach, which an application leaves out of 'compile-project' and
+    // of the final link with `config{prune_unreachable}`. Unit tests and benchmarks compile those they link
+    // against on demand. Module units are kept, as imports rather than headers reach them.
+    std::set<string> list_unreachable_sources(const Project& project) {
+        if (project.project_type != ProjectType::APPLICATION || !project.config.prune_unreachable.value_or(false)) {
+            return {};
+        }
+
+        const workspace::modification_identifier::RawDependencyTree graph{ workspace::modification_identifier::load_dependency_graph("src").value_or(workspace::modification_identifier::RawDependencyTree{}) };
+        const std::optional<std::set<string>> reachable_sources{ workspace::reachability::find_reachable_sources(graph) };
+
+        if (!reachable_sources.has_value()) {
+            return {};
+        }
+
+        std::set<string> module_units{};
+
+        if (std::ranges::any_of(graph, [](const auto& entry){ return workspace::cpp_modules::is_module_interface(entry.first); })) {
+            std::vector<string> files{};
+
+            for (const auto& [file, _]: graph) {
+                if (file.ends_with(".cpp") || workspace::cpp_modules::is_module_interface(file)) {
+                    files.push_back(file);
+                }
+            }
+
+            for (const auto& unit: workspace::cpp_modules::scan(files)) {
+                module_units.insert(unit.file);
+            }
+        }
+
+        std::set<string> unreachable_sources{};
+
+        for (const auto& [file, _]: graph) {
+            if ((file.ends_with(".c") || file.ends_with(".cpp")) && !module_units.contains(file) && !reachable_sources->contains(file)) {
+                unreachable_sources.insert(fs::path(file).make_preferred().string());
+            }
+        }
+
+        return unreachable_sources;
+    }
+
+    std::set<string> list_unreachable_objects(const Project& project) {
+        std::set<string> unreachable_objects{};
+
+        for (const auto& source: list_unreachable_sources(project)) {
+            // Formatted the way objects are listed for the link, without resolving them as they may not exist yet
+            unreachable_objects.insert((fs::path("build/binaries") / fs::path(source).lexically_relative("src")).replace_extension(".o").make_preferred().string());
+        }
+
+        return unreachable_objects;
+    }
+
+    // The files of `unreachable_sources` whose objects `list_files_to_link` links against a test or benchmark
+    // depending on `dependencies`
+    std::set<string> list_unreachable_sources_to_link(const std::vector<string>& dependencies, const std::vector<fs::path>& excluded_headers, const std::set<string>& unreachable_sources) {
+        std::set<string> sources_to_link{};
+
+        for (auto const& dependency: dependencies) {
+            const bool is_excluded = std::ranges::any_of(
+                excluded_headers,
+                [&dependency](const auto& excluded_header){ return fs::path(dependency).lexically_normal() == excluded_header.lexically_normal(); }
+            );
+
+            if (is_excluded || !dependency.starts_with("headers")) {
+                continue;
+            }
+
+            const string source{ (fs::path("src") / fs::path(dependency).lexically_relative("headers")).replace_extension(dependency.ends_with(".h") ? "c" : "cpp").make_preferred().string() };
+
+            if (unreachable_sources.contains(source)) {
+                sources_to_link.insert(source);
+            }
+        }
+
+        return sources_to_link;
+    }
+
+    // Marks affected the files whose objects switching unity builds on or off invalidates, as well as the
+    // members of batches that need compiling. Module units are never batched, and neither are files the final
+    // link leaves out, as a batch can only be linked whole.
+    std::optional<workspace::unity_build::Plan> plan_unity_build(const Project& project, const workspace::modification_identifier::SourceFiles& annotated_files, const std::optional<ModuleBuild>& module_build) {
+        if (!project.config.unity.value_or(false)) {
+            const std::vector<string> batched_files{ workspace::unity_build::discard() };
+
+            for (const auto& file: annotated_files) {
+                if (std::ranges::find(batched_files, file.file_name) != batched_files.end()) {
+                    file.affected = true;
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        const std::set<string> unreachable_objects{ list_unreachable_objects(project) };
+
+        std::vector<string> candidates{};
+        std::set<string> dirty_files{};
+
+        for (const auto& file: annotated_files) {
+            if (!file.file_name.starts_with("src/") || !file.file_name.ends_with(".cpp") || (module_build.has_value() && module_build->providers.contains(file.file_name))) {
+                continue;
+            }
+
+            const string stemmed_file{ file.file_name.substr(string("src/").length(), file.file_name.length() - string("src/.cpp").length()) };
+
+            // 'main.cpp' would clash with the one of every unit test linking the batch
+            if (stemmed_file.compare("main") != 0 && workspace::file_snapshot::exists("headers/" + stemmed_file + ".hpp")
+                && !unreachable_objects.contains(fs::path("build/binaries/" + stemmed_file + ".o").make_preferred().string())
+            ) {
+                candidates.push_back(file.file_name);
+
+                if (file.affected) {
+                    dirty_files.insert(file.file_name);
+                }
+            }
+        }
+
+        std::vector<workspace::unity_build::Collision> collisions{};
+
+        const workspace::unity_build::Plan plan{ workspace::unity_build::plan(
+            workspace::modification_identifier::load_dependency_graph("src").value_or(workspace::modification_identifier::RawDependencyTree{}),
+            candidates,
+            dirty_files,
+            project.config.unity_batch_size.value_or(workspace::unity_build::DEFAULT_BATCH_SIZE),
+            collisions
+        ) };
+
+        for (const auto& collision: collisions) {
+            cout << "[WARN] '" << collision.name << "' has internal linkage in " << collision.files.size() << " files, which are batched apart:";
+
+            for (const auto& file: collision.files) {
+                cout << " " << file;
+            }
+
+            cout << endl;
+        }
+
+        if (!collisions.empty()) {
+            cout << endl;
+        }
+
+        for (const auto& batch: plan.batches) {
+            if (batch.needs_compilation) {
+                for (const auto& file: annotated_files) {
+                    if (std::ranges::find(batch.members, file.file_name) != batch.members.end()) {
+                        file.affected = true;
+                    }
+                }
+            }
+        }
+
+        const std::vector<string> files_without_object{ workspace::unity_build::list_loose_files_without_object(plan) };
+
+        for (const auto& file: annotated_files) {
+            if (std::ranges::find(files_without_object, file.file_name) != files_without_object.end()) {
+                file.affected = true;
+            }
+        }
+
+        return plan;
+    }
+
+    // Relinks the libraries whose objects changed. Returns them all, or nothing if one failed to link.
+    std::optional<std::vector<string>> prepare_test_libraries(const Project& project) {
+        std::vector<string> libraries{};
+
+        for (const auto& library: workspace::test_libraries::plan()) {
+            std::vector<string> inputs{ library.libraries };
+            inputs.push_back(library.manifest);
+
+            if (is_binary_outdated(library.file, library.objects, inputs)) {
+                const int result = gnu_toolchain::create_shared_library(project, library.objects, library.libraries, library.file);
+
+                cout << "[BUILD]" << std::left << std::setw(6) << (result == 0 ? "[OK]" : "[NOK]") << library.file << " (" << library.objects.size() << " object(s))" << endl;
+
+                workspace::file_snapshot::invalidate(library.file);
+
+                if (result != 0) {
+                    return std::nullopt;
+                }
+            }
+
+            libraries.push_back(library.file);
+        }
+
+        return libraries;
+    }
+
+    // Combines the objects of each directory ahead of the final link, redoing only the groups a member of which
+    // changed, so that the final link takes dozens of inputs rather than every object
+    int perform_partial_linking(const Project& project, const std::vector<string>& directories_containing_binaries, const std::set<string>& excluded_objects, const string& executable_file) {
+        const std::vector<workspace::partial_link::Group> groups{ workspace::partial_link::plan(directories_containing_binaries, excluded_objects) };
+        std::vector<string> objects{ workspace::partial_link::list_ungrouped_objects(directories_containing_binaries, groups, excluded_objects) };
+
+        for (const auto& group: groups) {
+            if (is_binary_outdated(group.object, group.members, { group.manifest })) {
+                const int result = gnu_toolchain::create_relocatable_object(group.members, group.object);
+
+                cout << "[BUILD]" << std::left << std::setw(6) << (result == 0 ? "[OK]" : "[NOK]") << group.object << " (" << group.members.size() << " object(s))" << endl;
+
+                workspace::file_snapshot::invalidate(group.object);
+
+                if (result != 0) {
+                    return result;
+                }
+            }
+
+            objects.push_back(group.object);
+        }
+
+        if (!groups.empty()) {
+            cout << endl;
+        }
+
+        return gnu_toolchain::perform_linking_of_objects(project, objects, executable_file);
+    }
+
+    // Links the project once into a runner, relinking only when an object changed, which then loads every
+    // test shared object of `suites` in turn
+    void run_aggregated_unit_tests(const Project& project, const std::vector<string>& suites, const std::optional<string>& test_runtime_object, const bool track_allocations, const bool isolate_suites) {
+        std::vector<string> files_to_link{ workspace::test_runner::list_objects() };
+
+        if (test_runtime_object.has_value()) {
+            files_to_link.push_back(test_runtime_object.value());
+        }
+
+        const string runner_source{ workspace::test_runner::write_source() };
+        const string manifest{ workspace::test_runner::write_manifest(files_to_link) };
+        const string test_runner{ "build/test_binaries/unit_tests/cbt_test_runner" };
+
+        workspace::file_snapshot::invalidate(workspace::test_runner::TEST_RUNNER_PATH);
+
+        if (is_binary_outdated(test_runner, files_to_link, { runner_source, manifest })) {
+            const int result = gnu_toolchain::create_test_runner(project, runner_source, files_to_link, test_runner, track_allocations);
+
+            cout << endl << "[BUILD]" << std::left << std::setw(6) << (result == 0 ? "[OK]" : "[NOK]") << test_runner << " (" << files_to_link.size() << " object(s))" << endl;
+
+            if (result != 0) {
+                return;
+            }
+        }
+
+        string command{ test_runner + (isolate_suites ? " --isolate" : "") };
+
+        for (const auto& suite: suites) {
+            command += " " + suite;
+        }
+
+        [[maybe_unused]] const int result = gnu_toolchain::execute_test_binary(command);
+    }
+
+    const std::vector<string> WATCHED_PATHS{ "headers", "src", "tests", "project.cfg" };
+
+    // Brings the resident dependency graphs and the file snapshot up to date with `changes`
+    void apply_changes(const std::vector<string>& changes) {
+        for (const auto& change: changes) {
+            workspace::file_snapshot::invalidate(change);
+        }
+
+        if (std::ranges::find(changes, "project.cfg") != changes.end()) {
+            workspace::modification_identifier::discard_resident_graphs();
+        } else {
+            workspace::modification_identifier::notify_changes(changes);
+        }
+    }
+
+    void serve_daemon_request(const std::vector<string>& arguments) {
+        if (arguments.size() == 1 && arguments[0].compare("compile-project") == 0) {
+            commands::compile_project();
+        } else if (arguments.size() == 1 && arguments[0].compare("build-project") == 0) {
+            commands::build_project();
+        } else if (arguments.size() == 1 && arguments[0].compare("run-unit-tests") == 0) {
+            commands::run_unit_tests();
+        } else if (arguments.size() == 2 && arguments[0].compare("run-unit-tests") == 0 && arguments[1].compare("--track-allocations") == 0) {
+            commands::run_unit_tests(true);
+        } else {
+            throw std::invalid_argument("The daemon cannot serve '" + (arguments.empty() ? string() : arguments[0]) + "'");
+        }
+    }
 }
 
 namespace commands {
@@ -180,7 +725,28 @@ namespace commands {
         }
     }
 
+    void create_benchmark(const string& benchmark_name) {
+        const auto [is_valid, reason_if_any] = workspace::util::is_valid_file_name(benchmark_name);
+
+        if (!is_valid) {
+            cout << reason_if_any << endl;
+            return;
+        }
+
+        if (benchmark_name.starts_with("headers/")) {
+            cout << "Benchmark name cannot start with 'headers/'" << endl;
+            return;
+        }
+
+        const Project project = convert_cfg_to_model();
+
+        workspace::scaffold::create_missing_tool_headers(project);
+        workspace::scaffold::create_file(project, "tests/benchmarks/" + benchmark_name + ".cpp", true, true);
+    }
+
     void resolve_dependencies() {
+        const workspace::trace::Span span{ "resolve-dependencies" };
+
         const Project project = convert_cfg_to_model();
 
         workspace::scaffold::create_working_tree_as_necessary();
@@ -188,22 +754,64 @@ namespace commands {
         workspace::dependencies_manager::resolve_dependencies(project);
     }
 
-    void compile_project(const bool compile_as_dependency) {
+    void compile_project(const bool compile_as_dependency, const bool position_independent, const std::set<string>& unreachable_sources_to_compile) {
+        const workspace::trace::Span span{ "compile-project", { { "directory", fs::current_path().string() } } };
+
         workspace::scaffold::create_working_tree_as_necessary();
 
         const Project project = convert_cfg_to_model();
+        // Its own objects end up in 'libproject.so' as well when its tests link against shared libraries
+        const bool is_position_independent{ position_independent || project.config.shared_test_libraries.value_or(false) };
 
         if (!compile_as_dependency && are_dependencies_unresolved(project.dependencies)) {
             return;
         }
 
+        const bool has_position_independence_changed{ discard_binaries_if_position_independence_changed("build/binaries", is_position_independent) };
+
         const int literal_length_of_headers = string("headers/").length();
         const int literal_length_of_src = string("src/").length();
 
         workspace::modification_identifier::SourceFiles annotated_files = workspace::modification_identifier::list_all_files_annotated(project, compile_as_dependency);
+
+        if (has_position_independence_changed) {
+            for (auto& file: annotated_files) {
+                file.affected = true;
+            }
+        }
+
+        const std::optional<workspace::precompiled_header::Selection> precompiled_header_selection{ project.config.precompiled_header.value_or(false)
+            ? std::optional<workspace::precompiled_header::Selection>{ workspace::precompiled_header::select_headers(workspace::modification_identifier::load_dependency_graph("src").value_or(workspace::modification_identifier::RawDependencyTree{})) }
+            : std::nullopt };
+
+        if (precompiled_header_selection.has_value()) {
+            workspace::precompiled_header::mark_dependants_affected(precompiled_header_selection.value(), annotated_files);
+        }
+
+        const std::optional<ModuleBuild> module_build{ plan_module_build(project, annotated_files, compile_as_dependency, is_position_independent) };
+        const std::optional<workspace::unity_build::Plan> unity_plan{ compile_as_dependency ? std::nullopt : plan_unity_build(project, annotated_files, module_build) };
+
+        if (!compile_as_dependency) {
+            const std::set<string> unreachable_sources{ list_unreachable_sources(project) };
+            std::size_t left_out_count{ 0 };
+
+            // Recorded as failed, so that they are still compiled once a unit test or benchmark needs them
+            for (auto& file: annotated_files) {
+                if (file.affected && unreachable_sources.contains(file.file_name) && !unreachable_sources_to_compile.contains(file.file_name)) {
+                    file.affected = false;
+                    file.was_successful = false;
+                    ++left_out_count;
+                }
+            }
+
+            if (left_out_count != 0) {
+                cout << "[INFO] Number of file(s) unreachable from '" << workspace::reachability::ENTRY_POINT << "' and left out: " << left_out_count << endl;
+            }
+        }
+
         const int number_of_cpp_files_to_compile = std::ranges::count_if(
             annotated_files,
-            [](const auto& file){ return (file.file_name.ends_with(".c") || file.file_name.ends_with(".cpp")) && file.affected; }
+            [](const auto& file){ return (file.file_name.ends_with(".c") || file.file_name.ends_with(".cpp") || workspace::cpp_modules::is_module_interface(file.file_name)) && file.affected; }
         );
 
         if (number_of_cpp_files_to_compile == 0) {
@@ -213,58 +821,238 @@ namespace commands {
 
         cout << "[INFO] Number of file(s) to compile: " << number_of_cpp_files_to_compile << endl << endl;
 
-        for (auto const& dir_entry: fs::recursive_directory_iterator("headers")) {
-            if (fs::is_directory(dir_entry)) {
-                const string directory = dir_entry.path().string();
+        for (auto const& directory: workspace::file_snapshot::list_directory_recursively("headers")) {
+            if (workspace::file_snapshot::is_directory(directory)) {
                 const string directory_under_check = string("build/binaries/" + directory.substr(literal_length_of_headers));
 
-                if (!fs::exists(directory_under_check)) {
+                if (!workspace::file_snapshot::exists(directory_under_check)) {
                     workspace::scaffold::create_directory(string("."), directory_under_check, false, false);
                 }
             }
         }
 
-        cout << "[COMMAND] " << gnu_toolchain::get_compilation_command(project, compile_as_dependency) << endl << endl;
+        std::optional<workspace::precompiled_header::PrecompiledHeader> precompiled_header{ std::nullopt };
+
+        if (precompiled_header_selection.has_value()) {
+            precompiled_header = workspace::precompiled_header::prepare(project, precompiled_header_selection.value(), compile_as_dependency, is_position_independent);
+
+            if (precompiled_header.has_value() && precompiled_header->was_rebuilt) {
+                cout << "[PCH]" << std::left << std::setw(6) << (precompiled_header->was_successful ? "[OK]" : "[NOK]") << precompiled_header->header
+                    << " (" << precompiled_header->header_count << " header(s) in " << precompiled_header->build_time << "ms)" << endl << endl;
+            }
+
+            if (precompiled_header.has_value() && !precompiled_header->was_successful) {
+                cout << "[WARN] Compiling without the precompiled header" << endl << endl;
+            }
+        }
+
+        const std::optional<string> injected_header{ precompiled_header.has_value() && precompiled_header->was_successful
+            ? std::optional<string>{ precompiled_header->header }
+            : std::nullopt };
+
+        cout << "[COMMAND] " << gnu_toolchain::get_compilation_command(project, compile_as_dependency, injected_header, is_position_independent) << endl << endl;
 
         int files_succesfully_compiled_count{ 0 };
 
-        for (auto& file: annotated_files) {
-            if ((file.file_name.ends_with(".c") || file.file_name.ends_with(".cpp")) && file.affected) {
-                const bool is_c_file{ file.file_name.ends_with(".c") };
-                const int literal_length_of_extension = string(is_c_file ? ".c" : ".cpp").length();
+        // Each job compiles either a single file or a whole unity batch
+        std::vector<std::vector<const workspace::modification_identifier::SourceFile*>> files_to_compile{};
+        std::vector<workspace::job_scheduler::Job> jobs{};
 
-                const string stemmed_file = file.file_name.substr(
-                    literal_length_of_src,
-                    file.file_name.length() - (literal_length_of_src + literal_length_of_extension)
-                );
-                const string header_extension{ is_c_file ? ".h" : ".hpp" };
+        // Files never compiled before are assumed to be as hungry as the hungriest one on record
+        const std::size_t largest_recorded_memory{ std::ranges::max(annotated_files, {}, [](const auto& file){ return file.peak_memory; }).peak_memory };
+
+        std::set<string> batched_files{};
+
+        if (unity_plan.has_value()) {
+            workspace::unity_build::apply(unity_plan.value());
+
+            // Batches take the longest, so they start first
+            for (const auto& batch: unity_plan->batches) {
+                batched_files.insert(batch.members.begin(), batch.members.end());
+
+                if (!batch.needs_compilation) {
+                    continue;
+                }
+
+                std::vector<const workspace::modification_identifier::SourceFile*> members{};
+                std::size_t expected_memory{ 0 };
+
+                for (const auto& file: annotated_files) {
+                    if (std::ranges::find(batch.members, file.file_name) != batch.members.end()) {
+                        members.push_back(&file);
+                        expected_memory = std::max(expected_memory, file.peak_memory != 0 ? file.peak_memory : largest_recorded_memory);
+                    }
+                }
+
+                files_to_compile.push_back(members);
+                jobs.push_back(workspace::job_scheduler::Job{
+                    .label{ batch.file },
+                    .command{ gnu_toolchain::get_batch_compilation_command(project, batch.file, workspace::unity_build::get_object(batch), injected_header, is_position_independent) },
+                    .expected_memory{ expected_memory },
+                    .prerequisites{}
+                });
+            }
+        }
 
-                if (stemmed_file.compare("main") != 0 && !fs::exists("headers/" + stemmed_file + header_extension)) {
-                    cout << "SKIP " << ("headers/" + stemmed_file + header_extension) << " (No corresponding implementation file found!)" << endl;
-                } else {
-                    file.compilation_start_timestamp = workspace::modification_identifier::get_current_fileclock_timestamp();
+        for (const auto* file: workspace::modification_identifier::prioritise_for_compilation(annotated_files)) {
+            if (batched_files.contains(file->file_name)) {
+                continue;
+            }
+
+            const bool is_c_file{ file->file_name.ends_with(".c") };
+            const bool is_module_interface{ workspace::cpp_modules::is_module_interface(file->file_name) };
+            const bool is_module_unit{ module_build.has_value() && module_build->providers.contains(file->file_name) };
+            const int literal_length_of_extension = string(is_c_file ? ".c" : ".cpp").length();
+
+            const string stemmed_file = file->file_name.substr(
+                literal_length_of_src,
+                file->file_name.length() - (literal_length_of_src + literal_length_of_extension)
+            );
+            const string header_extension{ is_c_file ? ".h" : ".hpp" };
+
+            if (is_module_unit) {
+                // Interfaces keep their extension in the object name, so 'x.cppm' and its implementation 'x.cpp' do not clash
+                const string output_file{ is_module_interface ? file->file_name.substr(literal_length_of_src) : stemmed_file };
+                // Implementation files mirror a header, which is not the case for interfaces
+                const string output_directory{ fs::path("build/binaries/" + output_file).parent_path().generic_string() };
 
-                    const int result = gnu_toolchain::compile_file(project, file.file_name, stemmed_file, compile_as_dependency);
+                if (!workspace::file_snapshot::exists(output_directory)) {
+                    workspace::scaffold::create_directory(string("."), output_directory, false, false);
+                }
 
-                    file.compilation_end_timestamp = workspace::modification_identifier::get_current_fileclock_timestamp();
-                    file.was_successful = (result == 0);
+                files_to_compile.push_back({ file });
+                jobs.push_back(workspace::job_scheduler::Job{
+                    .label{ file->file_name },
+                    .command{ gnu_toolchain::get_module_unit_compilation_command(project, file->file_name, output_file, module_build->module_mapper, compile_as_dependency, is_position_independent) },
+                    .expected_memory{ file->peak_memory != 0 ? file->peak_memory : largest_recorded_memory },
+                    .prerequisites{}
+                });
+            } else if (stemmed_file.compare("main") != 0 && !workspace::file_snapshot::exists("headers/" + stemmed_file + header_extension)) {
+                cout << "SKIP " << ("headers/" + stemmed_file + header_extension) << " (No corresponding implementation file found!)" << endl;
+            } else {
+                files_to_compile.push_back({ file });
+                jobs.push_back(workspace::job_scheduler::Job{
+                    .label{ file->file_name },
+                    .command{ gnu_toolchain::get_file_compilation_command(project, file->file_name, stemmed_file, compile_as_dependency, is_c_file ? std::nullopt : injected_header, is_position_independent) },
+                    .expected_memory{ file->peak_memory != 0 ? file->peak_memory : largest_recorded_memory },
+                    .prerequisites{}
+                });
+            }
+        }
 
-                    cout << "[COMPILE]" << std::left << std::setw(6) << (file.was_successful ? "[OK]" : "[NOK]") << file.file_name <<  endl;
+        // A module unit compiles only once the interfaces it imports did, as it reads their compiled form
+        if (module_build.has_value()) {
+            for (std::size_t job{ 0 }; job < jobs.size(); ++job) {
+                const auto providers{ module_build->providers.find(files_to_compile[job].front()->file_name) };
+
+                if (providers == module_build->providers.end()) {
+                    continue;
+                }
 
-                    if (file.was_successful) {
-                        ++files_succesfully_compiled_count;
+                for (std::size_t prerequisite{ 0 }; prerequisite < jobs.size(); ++prerequisite) {
+                    if (std::ranges::find(providers->second, files_to_compile[prerequisite].front()->file_name) != providers->second.end()) {
+                        jobs[job].prerequisites.push_back(prerequisite);
                     }
                 }
             }
         }
 
+        std::size_t compile_work{ 0 };
+        const auto compilation_start{ std::chrono::steady_clock::now() };
+
+        workspace::job_scheduler::run(
+            jobs,
+            get_compilation_limits(project),
+            [&files_to_compile](const std::size_t job) {
+                const std::size_t timestamp{ workspace::modification_identifier::get_current_fileclock_timestamp() };
+
+                for (const auto* file: files_to_compile[job]) {
+                    file->compilation_start_timestamp = timestamp;
+                }
+            },
+            [&files_to_compile, &jobs, &files_succesfully_compiled_count, &compile_work](const std::size_t job, const workspace::job_scheduler::Outcome& outcome) {
+                const std::size_t timestamp{ workspace::modification_identifier::get_current_fileclock_timestamp() };
+                const bool was_successful{ outcome.exit_code == 0 };
+
+                // Members of a batch share its outcome, so a failed batch is retried next time
+                for (const auto* file: files_to_compile[job]) {
+                    file->compilation_end_timestamp = timestamp;
+                    file->was_successful = was_successful;
+                    file->peak_memory = outcome.peak_memory;
+                }
+
+                compile_work += timestamp - files_to_compile[job].front()->compilation_start_timestamp;
+
+                cout << "[COMPILE]" << std::left << std::setw(6) << (was_successful ? "[OK]" : "[NOK]") << jobs[job].label
+                    << (files_to_compile[job].size() > 1 ? " (" + std::to_string(files_to_compile[job].size()) + " files)" : "")
+                    << (outcome.was_skipped ? " (Skipped: a module it imports failed to compile)" : "") << endl;
+
+                if (was_successful) {
+                    files_succesfully_compiled_count += static_cast<int>(files_to_compile[job].size());
+                }
+            }
+        );
+
+        const auto compile_wall_time{ std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - compilation_start).count() };
+
         cout << endl << "[INFO] File(s) successfully compiled: " << files_succesfully_compiled_count << " out of " << number_of_cpp_files_to_compile << endl;
 
+        workspace::file_snapshot::invalidate("build");
+
         workspace::scaffold::purge_old_binaries("build/binaries/", annotated_files);
         workspace::modification_identifier::persist_annotations(annotated_files);
+
+        if (!compile_as_dependency) {
+            workspace::build_analysis::Durations durations{
+                { workspace::build_analysis::COMPILE_WALL_TIME, static_cast<std::size_t>(compile_wall_time) },
+                { workspace::build_analysis::COMPILE_WORK, compile_work }
+            };
+
+            const workspace::build_analysis::Durations recorded_durations{ workspace::build_analysis::load_durations() };
+
+            std::size_t compared_files{ 0 };
+            std::size_t time_without_precompiled_header{ 0 };
+            std::size_t time_with_precompiled_header{ 0 };
+
+            // Compilations without the precompiled header serve as the baseline for those with it
+            for (const auto& compiled_files: files_to_compile) {
+                const auto* file{ compiled_files.front() };
+
+                if (compiled_files.size() != 1 || !file->was_successful || file->file_name.ends_with(".c") || (module_build.has_value() && module_build->providers.contains(file->file_name))) {
+                    continue;
+                }
+
+                const string step{ workspace::build_analysis::get_compilation_without_precompiled_header_step(file->file_name) };
+                const std::size_t duration{ file->compilation_end_timestamp - file->compilation_start_timestamp };
+
+                if (!injected_header.has_value()) {
+                    durations[step] = duration;
+                } else if (const auto it = recorded_durations.find(step); it != recorded_durations.end()) {
+                    ++compared_files;
+                    time_without_precompiled_header += it->second;
+                    time_with_precompiled_header += duration;
+                }
+            }
+
+            workspace::build_analysis::record_durations(durations);
+
+            if (compared_files != 0 && time_without_precompiled_header != 0) {
+                std::ostringstream saving;
+                saving << std::fixed << std::setprecision(1)
+                    << 100.0 * (static_cast<double>(time_without_precompiled_header) - static_cast<double>(time_with_precompiled_header)) / static_cast<double>(time_without_precompiled_header);
+
+                cout << "[INFO] Precompiled header: " << compared_files << " file(s) compiled in " << time_with_precompiled_header << "ms against "
+                    << time_without_precompiled_header << "ms without it (" << saving.str() << "% saved)" << endl;
+            }
+        }
     }
 
     void clear_build() {
+        // Its resident state describes the build about to be deleted, and its socket lives in '.internals/'
+        if (workspace::build_daemon::stop()) {
+            cout << "[INFO] Daemon stopped" << endl;
+        }
+
         if (fs::remove_all(fs::current_path() / "build")) {
             cout << std::right << std::setw(8) << "RECREATE " << "build/" << endl;
         }
@@ -277,6 +1065,8 @@ namespace commands {
     }
 
     void build_project() {
+        const workspace::trace::Span span{ "build-project" };
+
         const Project project = convert_cfg_to_model();
 
         if (project.project_type == ProjectType::LIBRARY) {
@@ -303,6 +1093,10 @@ namespace commands {
 
         list_directories_containing_binaries(non_empty_directories, "build/binaries");
         list_directories_containing_binaries(non_empty_directories, "build/dependencies");
+
+        if (workspace::file_snapshot::exists(workspace::unity_build::UNITY_PATH)) {
+            list_directories_containing_binaries(non_empty_directories, workspace::unity_build::UNITY_PATH);
+        }
         
         if (non_empty_directories.empty()) {
             cout << "No binaries present! Run 'cbt compile-project' first." << endl;
@@ -311,26 +1105,67 @@ namespace commands {
 
         std::vector<string> directories_containing_binaries(non_empty_directories.begin(), non_empty_directories.end());
 
+        choose_linker_if_needed(project, directories_containing_binaries);
+
         #if defined(_WIN32) || defined(_WIN64)
         const string BINARY_NAME{ project.name + ".exe" };
         #else
         const string BINARY_NAME{ project.name };
         #endif
 
-        const int result = gnu_toolchain::perform_linking(project, directories_containing_binaries, string("build") + SEPARATOR + BINARY_NAME);
+        const std::set<string> unreachable_objects{ list_unreachable_objects(project) };
+
+        if (!unreachable_objects.empty()) {
+            cout << "[INFO] Number of object(s) unreachable from '" << workspace::reachability::ENTRY_POINT << "' and left out: " << unreachable_objects.size() << endl << endl;
+        }
+
+        const auto linking_start{ std::chrono::steady_clock::now() };
+        const int result = project.config.partial_link.value_or(false)
+            ? perform_partial_linking(project, directories_containing_binaries, unreachable_objects, string("build") + SEPARATOR + BINARY_NAME)
+            : unreachable_objects.empty()
+                ? gnu_toolchain::perform_linking(project, directories_containing_binaries, string("build") + SEPARATOR + BINARY_NAME)
+                : gnu_toolchain::perform_linking_of_objects(project, workspace::partial_link::list_ungrouped_objects(directories_containing_binaries, {}, unreachable_objects), string("build") + SEPARATOR + BINARY_NAME);
+
+        workspace::build_analysis::record_durations({
+            { workspace::build_analysis::LINK_STEP, static_cast<std::size_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - linking_start).count()) }
+        });
 
         cout << "[BUILD]" << std::left << std::setw(6) << (result == 0 ? "[OK]" : "[NOK]") << workspace::util::get_platform_formatted_filename("build/" + BINARY_NAME) << endl;
     }
 
-    void run_unit_tests() {
+    void run_unit_tests(const bool track_allocations) {
+        const workspace::trace::Span span{ "run-unit-tests" };
+
         workspace::scaffold::create_working_tree_as_necessary();
 
         const Project project = convert_cfg_to_model();
 
+        workspace::scaffold::create_missing_tool_headers(project);
+
         if (are_dependencies_unresolved(project.dependencies)) {
             return;
         }
 
+        discard_binaries_if_tracking_changed("build/test_binaries/unit_tests", track_allocations);
+
+        if (workspace::linker::needs_benchmark(project)) {
+            std::set<string> non_empty_directories;
+
+            list_directories_containing_binaries(non_empty_directories, "build/binaries");
+
+            if (!non_empty_directories.empty()) {
+                list_directories_containing_binaries(non_empty_directories, "build/dependencies");
+
+                if (workspace::file_snapshot::exists(workspace::unity_build::UNITY_PATH)) {
+                    list_directories_containing_binaries(non_empty_directories, workspace::unity_build::UNITY_PATH);
+                }
+
+                choose_linker_if_needed(project, std::vector<string>(non_empty_directories.begin(), non_empty_directories.end()));
+            }
+        }
+
+        discard_binaries_if_linker_changed("build/test_binaries", gnu_toolchain::get_linker_signature(project));
+
         const workspace::modification_identifier::RawDependencyTree tree = workspace::modification_identifier::get_files_to_test(project);
 
         if (tree.empty()) {
@@ -347,80 +1182,570 @@ namespace commands {
         #endif
 
         const fs::path harness{ "headers/cbt_tools/test_harness.hpp" };
+        const fs::path alloc_tracker{ "headers/cbt_tools/alloc_tracker.hpp" };
 
-        std::vector<fs::path> binaries_to_execute{};
-        const size_t literal_length_of_headers{ std::string("headers/").length() };
-        const size_t literal_length_of_dependencies{ std::string(".internals/dh_symlinks/").length() };
+        std::vector<std::tuple<string, fs::path>> binaries_to_execute{};
+        workspace::build_analysis::Durations test_durations{};
+
+        const auto milliseconds_since = [](const std::chrono::steady_clock::time_point& start) {
+            return static_cast<std::size_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+        };
+
+        const workspace::test_runner::Mode runner_mode{ workspace::test_runner::get_mode(project) };
+        bool aggregates_tests{ runner_mode != workspace::test_runner::Mode::EXECUTABLES };
+
+        if (aggregates_tests && !workspace::test_runner::is_supported()) {
+            cout << "[WARN] 'config{unit_test_runner}' is not supported on this platform, building one executable per test file" << endl << endl;
+            aggregates_tests = false;
+        }
+
+        std::optional<workspace::test_runtime::TestRuntime> test_runtime{ workspace::test_runtime::prepare(project, track_allocations, aggregates_tests) };
+
+        // Otherwise every shared object would bring its own allocation hooks
+        if (aggregates_tests && track_allocations && !(test_runtime.has_value() && test_runtime->was_successful && test_runtime->object.has_value())) {
+            cout << "[WARN] Tracking allocations in aggregated tests requires the prebuilt test runtime, building one executable per test file" << endl << endl;
+            aggregates_tests = false;
+            test_runtime = workspace::test_runtime::prepare(project, track_allocations);
+        }
+
+        if (test_runtime.has_value() && test_runtime->was_rebuilt) {
+            cout << "[PCH]" << std::left << std::setw(6) << (test_runtime->was_successful ? "[OK]" : "[NOK]") << test_runtime->header
+                << " (test runtime in " << test_runtime->build_time << "ms)" << endl << endl;
+        }
+
+        if (test_runtime.has_value() && !test_runtime->was_successful) {
+            cout << "[WARN] Compiling tests without the prebuilt test runtime" << endl << endl;
+        }
+
+        const bool uses_test_runtime{ test_runtime.has_value() && test_runtime->was_successful };
+        const std::optional<string> test_runtime_header{ uses_test_runtime ? std::optional<string>{ test_runtime->header } : std::nullopt };
+
+        if (const std::set<string> unreachable_sources{ list_unreachable_sources(project) }; !unreachable_sources.empty()) {
+            // The test runner and the shared test libraries link every object
+            std::set<string> sources_to_compile{ aggregates_tests || project.config.shared_test_libraries.value_or(false) ? unreachable_sources : std::set<string>{} };
+
+            for (auto const& [file, dependencies]: tree) {
+                const fs::path scoped_directory_of_file{ fs::path{ file }.parent_path().lexically_relative("tests/unit_tests") };
+                const fs::path corresponding_header_file{ fs::path("headers" / scoped_directory_of_file / fs::path(file).stem().replace_extension(file.starts_with("tests/unit_tests/c/") ? ".h" : ".hpp")) };
+
+                sources_to_compile.merge(list_unreachable_sources_to_link(dependencies, { corresponding_header_file, harness, alloc_tracker }, unreachable_sources));
+            }
+
+            if (!sources_to_compile.empty()) {
+                compile_project(false, false, sources_to_compile);
+                cout << endl;
+            }
+        }
+
+        std::optional<std::vector<string>> test_libraries{ std::nullopt };
+
+        if (!aggregates_tests && project.config.shared_test_libraries.value_or(false)) {
+            if (!workspace::test_libraries::is_supported()) {
+                cout << "[WARN] 'config{shared_test_libraries}' is not supported on this platform, linking objects directly" << endl << endl;
+            } else if (test_libraries = prepare_test_libraries(project); !test_libraries.has_value()) {
+                cout << endl << "[WARN] Could not link the shared test libraries, linking objects directly. Objects compiled before 'config{shared_test_libraries}' was turned on lack '-fPIC', which 'cbt clear-build' fixes." << endl << endl;
+            } else {
+                cout << endl;
+            }
+        }
+
+        const string entry_point_header{ aggregates_tests ? workspace::test_runner::write_entry_point_header() : "" };
 
-        cout << "[COMMAND] " << gnu_toolchain::get_test_execution_command(project, EXTENSION) << endl << endl;
+        cout << "[COMMAND] " << (aggregates_tests
+            ? gnu_toolchain::get_test_shared_object_command(project, entry_point_header, track_allocations, test_runtime_header)
+            : gnu_toolchain::get_test_execution_command(project, EXTENSION, track_allocations, test_runtime_header)) << endl << endl;
+
+        std::vector<string> suites_to_execute{};
 
         for (auto const& [file, dependencies]: tree) {
             const bool is_c_file{ file.starts_with("tests/unit_tests/c/") };
 
-            std::vector<string> files_to_link{ file };
-            const fs::path scoped_directory_of_file{ fs::relative(fs::path{ file }.parent_path(), "tests/unit_tests") };
+            const fs::path scoped_directory_of_file{ fs::path{ file }.parent_path().lexically_relative("tests/unit_tests") };
             const fs::path build_directory_under_check{ "build/test_binaries/unit_tests" / scoped_directory_of_file };
 
             if (!fs::exists(build_directory_under_check)) {
                 workspace::scaffold::create_directory(string("."), build_directory_under_check.string(), true, false);
             }
 
+            if (aggregates_tests) {
+                const fs::path shared_object{ fs::path("build/test_binaries/unit_tests" / scoped_directory_of_file / fs::path(file).stem().replace_extension(".so")) };
+                const auto test_compilation_start{ std::chrono::steady_clock::now() };
+                const int result = gnu_toolchain::create_test_shared_object(project, file, shared_object.string(), entry_point_header, track_allocations, test_runtime_header);
+
+                test_durations[workspace::build_analysis::get_test_compilation_step(file)] = milliseconds_since(test_compilation_start);
+
+                cout << "[COMPILE]" << std::left << std::setw(6) << (result == 0 ? "[OK]" : "[NOK]") << workspace::util::get_platform_formatted_filename(shared_object) << endl;
+
+                if (result == 0) {
+                    suites_to_execute.push_back(shared_object.string());
+                }
+
+                continue;
+            }
+
             const string header_extension{ is_c_file ? ".h" : ".hpp" };
             const fs::path corresponding_header_file{ fs::path("headers" / scoped_directory_of_file / fs::path(file).stem().replace_extension(header_extension)) };
 
-            for (auto const& dependency: dependencies) {
-                if (!fs::equivalent(corresponding_header_file, dependency) && !fs::equivalent(dependency, harness)) {
-                    const bool is_own_dependency{ dependency.starts_with("headers") };
+            std::vector<string> files_to_link{ test_libraries.has_value() ? std::vector<string>{ file } : list_files_to_link(file, dependencies, { corresponding_header_file, harness, alloc_tracker }) };
 
-                    const fs::path corresponding_implementation_file{ (is_own_dependency
-                        ? fs::path("src/" + dependency.substr(literal_length_of_headers)).replace_extension(is_c_file ? "c" : "cpp")
-                        : fs::path([&dependency](){
-                                const string symlink{ fs::read_symlink(dependency.substr(0, dependency.rfind("/"))).string() };
-
-                                const size_t start{ symlink.rfind("dependencies/") };
-                                const size_t stop{ symlink.rfind("/headers") };
+            if (uses_test_runtime && test_runtime->object.has_value()) {
+                files_to_link.push_back(test_runtime->object.value());
+            }
 
-                                const std::string shortened_symlink{ symlink.substr(start, stop - start) };
+            const fs::path test_binary{ fs::path("build/test_binaries/unit_tests" / scoped_directory_of_file / fs::path(file).stem().replace_extension(EXTENSION)) };
 
-                                const size_t dep_start{ shortened_symlink.find("/") };
-                                const size_t dep_stop{ shortened_symlink.find("@") };
+            // Only the implementation under test changed, and it lives in the libraries
+            if (test_libraries.has_value() && !is_binary_outdated(test_binary, files_to_link, dependencies)) {
+                fs::last_write_time(test_binary, fs::file_time_type::clock::now());
 
-                                const std::string dependency_name{ shortened_symlink.substr(dep_start + 1, dep_stop - dep_start - 1) };
+                cout << "[COMPILE]" << std::left << std::setw(6) << "[OK]" << workspace::util::get_platform_formatted_filename(test_binary) << " (not relinked)" << endl;
 
-                                return shortened_symlink + "/src/" + dependency.substr(dependency.find(dependency_name) + dependency_name.length() + 1);
-                            }())
-                        ).replace_extension(is_c_file ? "c" : "cpp")
-                    };
+                binaries_to_execute.push_back({ file, test_binary });
+                continue;
+            }
 
-                    if (fs::exists(corresponding_implementation_file)) {
-                        const fs::path corresponding_binary{ (is_own_dependency
-                            ? fs::path("build/binaries/" + dependency.substr(literal_length_of_headers))
-                            : fs::path("build/dependencies/" + dependency.substr(literal_length_of_dependencies))
-                            ).replace_extension("o")
-                        };
-
-                        if (!fs::exists(corresponding_binary)) {
-                            throw std::runtime_error("Corresponding binary for '" + workspace::util::get_platform_formatted_filename(dependency) + "' not found! Run `cbt " + (is_own_dependency ? "compile-project" : "resolve-dependencies") + "`.");
-                        } else {
-                            files_to_link.push_back(corresponding_binary.string());
-                        }
-                    }
-                }
+            if (test_libraries.has_value()) {
+                files_to_link.insert(files_to_link.end(), test_libraries->begin(), test_libraries->end());
             }
 
-            const fs::path test_binary{ fs::path("build/test_binaries/unit_tests" / scoped_directory_of_file / fs::path(file).stem().replace_extension(EXTENSION)) };
-            const int result = gnu_toolchain::create_test_binary(project, files_to_link, test_binary.string());
+            const std::optional<string> library_directory{ test_libraries.has_value()
+                ? std::optional<string>{ fs::path(workspace::test_libraries::TEST_LIBRARIES_PATH).lexically_relative(test_binary.parent_path()).generic_string() }
+                : std::nullopt };
+
+            const auto test_compilation_start{ std::chrono::steady_clock::now() };
+            const int result = gnu_toolchain::create_test_binary(project, files_to_link, test_binary.string(), track_allocations, test_runtime_header, library_directory);
+
+            test_durations[workspace::build_analysis::get_test_compilation_step(file)] = milliseconds_since(test_compilation_start);
             
             cout << "[COMPILE]" << std::left << std::setw(6) << (result == 0 ? "[OK]" : "[NOK]") << workspace::util::get_platform_formatted_filename(test_binary) << endl;
 
             if (result == 0) {
-                binaries_to_execute.push_back(test_binary);
+                binaries_to_execute.push_back({ file, test_binary });
             }
         }
         
-        for (auto const& test_binary: binaries_to_execute) {
+        if (!suites_to_execute.empty()) {
+            run_aggregated_unit_tests(
+                project,
+                suites_to_execute,
+                uses_test_runtime ? test_runtime->object : std::nullopt,
+                track_allocations,
+                runner_mode == workspace::test_runner::Mode::ISOLATED
+            );
+        }
+
+        for (auto const& [file, test_binary]: binaries_to_execute) {
+            const auto test_execution_start{ std::chrono::steady_clock::now() };
             [[maybe_unused]] const int result = gnu_toolchain::execute_test_binary(workspace::util::get_platform_formatted_filename(test_binary));
+
+            test_durations[workspace::build_analysis::get_test_execution_step(file)] = milliseconds_since(test_execution_start);
+        }
+
+        workspace::build_analysis::record_durations(test_durations);
+    }
+
+    void run_benchmarks(const std::optional<string>& baseline_to_compare, const std::optional<string>& baseline_to_save, const double threshold, const bool collect_hardware_counters, const bool track_allocations) {
+        const workspace::trace::Span span{ "run-benchmarks" };
+
+        workspace::scaffold::create_working_tree_as_necessary();
+
+        const Project project = convert_cfg_to_model();
+
+        workspace::scaffold::create_missing_tool_headers(project);
+
+        if (are_dependencies_unresolved(project.dependencies)) {
+            return;
+        }
+
+        const bool has_benchmarks = fs::exists("tests/benchmarks") && std::ranges::any_of(
+            fs::recursive_directory_iterator("tests/benchmarks"),
+            [](const auto& entry){ return entry.is_regular_file() && entry.path().string().ends_with(".cpp"); }
+        );
+
+        if (!has_benchmarks) {
+            cout << "[INFO] No benchmarks found under 'tests/benchmarks/'. Run 'cbt create-benchmark <name>' first." << endl;
+            return;
+        }
+
+        discard_binaries_if_tracking_changed("build/test_binaries/benchmarks", track_allocations);
+
+        const workspace::modification_identifier::RawDependencyTree tree = workspace::modification_identifier::get_benchmarks(project);
+        
+        #if defined(_WIN32) || defined(_WIN64)
+        const string EXTENSION{ ".exe" };
+        #else
+        const string EXTENSION{ "" };
+        #endif
+
+        const fs::path bench_harness{ "headers/cbt_tools/bench_harness.hpp" };
+        const fs::path test_harness{ "headers/cbt_tools/test_harness.hpp" };
+        const fs::path alloc_tracker{ "headers/cbt_tools/alloc_tracker.hpp" };
+
+        if (const std::set<string> unreachable_sources{ list_unreachable_sources(project) }; !unreachable_sources.empty()) {
+            std::set<string> sources_to_compile{};
+
+            for (auto const& [file, dependencies]: tree) {
+                sources_to_compile.merge(list_unreachable_sources_to_link(dependencies, { bench_harness, test_harness, alloc_tracker }, unreachable_sources));
+            }
+
+            if (!sources_to_compile.empty()) {
+                compile_project(false, false, sources_to_compile);
+                cout << endl;
+            }
+        }
+
+        std::vector<std::tuple<fs::path, std::vector<string>>> benchmarks_to_compile{};
+        std::vector<fs::path> binaries_to_execute{};
+
+        for (auto const& [file, dependencies]: tree) {
+            const fs::path scoped_directory_of_file{ fs::path{ file }.parent_path().lexically_relative("tests/benchmarks") };
+            const fs::path build_directory_under_check{ "build/test_binaries/benchmarks" / scoped_directory_of_file };
+
+            if (!fs::exists(build_directory_under_check)) {
+                workspace::scaffold::create_directory(string("."), build_directory_under_check.string(), true, false);
+            }
+
+            const std::vector<string> files_to_link{ list_files_to_link(file, dependencies, { bench_harness, test_harness, alloc_tracker }) };
+            const fs::path benchmark_binary{ fs::path("build/test_binaries/benchmarks" / scoped_directory_of_file / fs::path(file).stem().replace_extension(EXTENSION)) };
+
+            if (is_binary_outdated(benchmark_binary, files_to_link, dependencies)) {
+                benchmarks_to_compile.push_back(std::make_tuple(benchmark_binary, files_to_link));
+            } else {
+                binaries_to_execute.push_back(benchmark_binary);
+            }
+        }
+
+        if (benchmarks_to_compile.empty()) {
+            cout << "[INFO] Nothing to compile. All benchmarks are up-to-date!" << endl;
+        } else {
+            cout << "[INFO] Number of benchmark(s) to compile: " << benchmarks_to_compile.size() << endl << endl;
+            cout << "[COMMAND] " << gnu_toolchain::get_benchmark_execution_command(project, EXTENSION, track_allocations) << endl << endl;
+
+            for (auto const& [benchmark_binary, files_to_link]: benchmarks_to_compile) {
+                const int result = gnu_toolchain::create_benchmark_binary(project, files_to_link, benchmark_binary.string(), track_allocations);
+
+                cout << "[COMPILE]" << std::left << std::setw(6) << (result == 0 ? "[OK]" : "[NOK]") << workspace::util::get_platform_formatted_filename(benchmark_binary) << endl;
+
+                if (result == 0) {
+                    binaries_to_execute.push_back(benchmark_binary);
+                }
+            }
+        }
+
+        std::sort(binaries_to_execute.begin(), binaries_to_execute.end());
+
+        const fs::path results_file{ ".internals/tmp/benchmark_results.txt" };
+        workspace::util::set_env("CBT_BENCHMARK_RESULTS", results_file.string());
+
+        if (collect_hardware_counters) {
+            workspace::util::set_env("CBT_BENCHMARK_COUNTERS", "1");
+        }
+
+        std::vector<std::tuple<string, workspace::benchmark_baseline::BenchmarkRecord>> records{};
+        int failures_count{ 0 };
+
+        for (auto const& benchmark_binary: binaries_to_execute) {
+            const string benchmark{ fs::relative(benchmark_binary, "build/test_binaries/benchmarks").replace_extension("").generic_string() };
+
+            if (fs::exists(results_file)) {
+                fs::remove(results_file);
+            }
+
+            const int result = gnu_toolchain::execute_test_binary(workspace::util::get_platform_formatted_filename(benchmark_binary));
+            const workspace::benchmark_baseline::BenchmarkRecord record{ workspace::benchmark_baseline::parse_harness_output(results_file) };
+
+            // A crashed benchmark would otherwise overwrite its baselines with an empty record
+            if (result != 0 || record.results.empty()) {
+                cout << "[WARN] Benchmark '" << benchmark << "' " << (result != 0 ? "failed" : "reported no results") << ", its baselines are left untouched" << endl << endl;
+                ++failures_count;
+                continue;
+            }
+
+            records.push_back(std::make_tuple(benchmark, record));
+        }
+
+        if (fs::exists(results_file)) {
+            fs::remove(results_file);
+        }
+
+        int regressions_count{ 0 };
+
+        if (baseline_to_compare.has_value()) {
+            cout << "[COMPARE] Against baseline '" << baseline_to_compare.value() << "' (threshold: " << threshold * 100 << "%)" << endl << endl;
+
+            for (auto const& [benchmark, record]: records) {
+                const auto baseline_record{ workspace::benchmark_baseline::load(baseline_to_compare.value(), benchmark) };
+
+                if (baseline_record.has_value() && (baseline_record->compiler != record.compiler || baseline_record->machine != record.machine)) {
+                    cout << "[WARN] Baseline for '" << benchmark << "' was recorded with '" << baseline_record->compiler << "' on '" << baseline_record->machine << "'" << endl;
+                }
+
+                for (auto const& current: record.results) {
+                    std::optional<workspace::benchmark_baseline::BenchmarkResult> baseline{ std::nullopt };
+
+                    if (baseline_record.has_value()) {
+                        const auto it = std::ranges::find_if(baseline_record->results, [&current](const auto& result){ return result.title == current.title; });
+
+                        if (it != baseline_record->results.end()) {
+                            baseline = *it;
+                        }
+                    }
+
+                    const auto comparison{ workspace::benchmark_baseline::compare(baseline, current, threshold) };
+
+                    cout << std::left << std::setw(12) << workspace::benchmark_baseline::verdict_to_string(comparison.verdict) << benchmark << " :: " << current.title;
+
+                    if (comparison.verdict != workspace::benchmark_baseline::Verdict::NEW) {
+                        cout << std::fixed << std::setprecision(2)
+                            << " (median " << comparison.baseline_median << " ns -> " << comparison.current_median << " ns, "
+                            << std::showpos << (comparison.current_median / comparison.baseline_median - 1) * 100 << std::noshowpos << "%, "
+                            << "p = " << std::setprecision(4) << comparison.p_value << ")"
+                            << std::defaultfloat;
+                    }
+
+                    cout << endl;
+
+                    if (baseline.has_value()) {
+                        const string counter_changes{ workspace::benchmark_baseline::describe_counter_changes(baseline.value(), current) };
+
+                        if (!counter_changes.empty()) {
+                            cout << std::setw(12) << "" << "counters: " << counter_changes << endl;
+                        }
+                    }
+
+                    if (comparison.verdict == workspace::benchmark_baseline::Verdict::REGRESSED) {
+                        ++regressions_count;
+                    }
+                }
+            }
+
+            cout << endl;
+        }
+
+        // Persisting a regressed run would make it the reference of the next comparison, hiding the regression
+        if (regressions_count != 0) {
+            throw std::runtime_error(std::to_string(regressions_count) + " benchmark(s) regressed beyond the threshold of " + std::to_string(static_cast<int>(threshold * 100)) + "%, baselines are left untouched");
+        }
+
+        for (auto const& [benchmark, record]: records) {
+            workspace::benchmark_baseline::persist(workspace::benchmark_baseline::LATEST_BASELINE, benchmark, record);
+
+            if (baseline_to_save.has_value()) {
+                workspace::benchmark_baseline::persist(baseline_to_save.value(), benchmark, record);
+            }
+        }
+
+        cout << "[INFO] Results saved as baseline '" << workspace::benchmark_baseline::LATEST_BASELINE << "'"
+            << (baseline_to_save.has_value() ? " and '" + baseline_to_save.value() + "'" : "") << endl;
+
+        if (failures_count != 0) {
+            throw std::runtime_error(std::to_string(failures_count) + " benchmark(s) failed to run");
+        }
+    }
+
+    void watch(const string& action) {
+        const std::chrono::milliseconds DEBOUNCE_PERIOD{ 200 };
+
+        workspace::modification_identifier::keep_graphs_resident();
+
+        const auto run_action = [&action]() {
+            try {
+                compile_project();
+
+                if (action.compare("build") == 0) {
+                    cout << endl;
+                    build_project();
+                } else if (action.compare("test") == 0) {
+                    cout << endl;
+                    run_unit_tests();
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Exception: " << e.what() << endl;
+            }
+        };
+
+        // Started ahead of the first pass, so that edits made while it runs trigger the next one
+        workspace::file_watcher::poll_changes(WATCHED_PATHS);
+
+        run_action();
+
+        while (true) {
+            cout << endl << "[WATCH] Waiting for changes under 'headers/', 'src/', 'tests/' and to 'project.cfg' (Ctrl+C to stop)" << endl;
+
+            const std::vector<string> changes{ workspace::file_watcher::wait_for_changes(WATCHED_PATHS, DEBOUNCE_PERIOD) };
+            const auto detection{ std::chrono::steady_clock::now() };
+
+            cout << endl;
+
+            for (const auto& change: changes) {
+                cout << "[WATCH] Changed " << change << endl;
+            }
+
+            apply_changes(changes);
+            // Building and testing write there without going through the snapshots
+            workspace::file_snapshot::invalidate("build");
+            workspace::file_snapshot::invalidate("dependencies");
+
+            cout << endl;
+
+            run_action();
+
+            cout << endl << "[WATCH] Done in " << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - detection).count() << "ms" << endl;
+        }
+    }
+
+    void start_daemon() {
+        const int pid{ workspace::build_daemon::start([is_watching = false](const std::vector<string>& arguments) mutable {
+            if (!is_watching) {
+                // Nothing is resident before the first request, so only later ones need to catch up
+                workspace::modification_identifier::keep_graphs_resident();
+                workspace::file_watcher::poll_changes(WATCHED_PATHS);
+                is_watching = true;
+            } else {
+                apply_changes(workspace::file_watcher::poll_changes(WATCHED_PATHS));
+                // Other invocations, e.g. 'clear-build' or 'resolve-dependencies', still run in-process
+                workspace::file_snapshot::invalidate("build");
+                workspace::file_snapshot::invalidate("dependencies");
+            }
+
+            serve_daemon_request(arguments);
+        }) };
+
+        cout << "[INFO] Daemon started (pid " << pid << "), listening on '" << workspace::build_daemon::SOCKET_PATH << "'" << endl;
+        cout << "[INFO] 'compile-project', 'build-project' and 'run-unit-tests' are now served by it until idle for "
+            << workspace::build_daemon::IDLE_TIMEOUT.count() << " minutes" << endl;
+    }
+
+    void stop_daemon() {
+        if (workspace::build_daemon::stop()) {
+            cout << "[INFO] Daemon stopped" << endl;
+        } else {
+            cout << "[INFO] No daemon running for this workspace" << endl;
+        }
+    }
+
+    void analyse_build(const unsigned int jobs) {
+        const std::optional<workspace::modification_identifier::RawDependencyTree> sources{ workspace::modification_identifier::load_dependency_graph("src") };
+
+        if (!sources.has_value()) {
+            cout << "No build recorded yet! Run 'cbt compile-project' first." << endl;
+            return;
+        }
+
+        const workspace::build_analysis::Report report{ workspace::build_analysis::analyse(
+            sources.value(),
+            workspace::modification_identifier::load_dependency_graph("tests/unit_tests").value_or(workspace::modification_identifier::RawDependencyTree{}),
+            workspace::modification_identifier::get_recorded_compilation_durations(),
+            workspace::build_analysis::load_durations(),
+            jobs
+        ) };
+
+        const auto as_seconds = [](const std::size_t milliseconds) {
+            std::ostringstream stream;
+            stream << std::fixed << std::setprecision(2) << (milliseconds / 1000.0) << "s";
+
+            return stream.str();
+        };
+
+        cout << "[INFO] Critical path (" << as_seconds(report.critical_path_length) << ")" << endl;
+
+        for (const auto& step: report.critical_path) {
+            cout << std::right << std::setw(10) << as_seconds(step.duration) << "  " << step.name << endl;
+        }
+
+        cout << endl
+            << "[INFO] Total compile work:        " << as_seconds(report.compile_work) << " across " << sources.value().size() << " translation unit(s)" << endl
+            << "[INFO] Longest compilation:       " << as_seconds(report.longest_compilation) << endl
+            << "[INFO] Theoretical parallelism:   " << std::fixed << std::setprecision(2) << report.theoretical_parallelism << "x" << endl;
+
+        if (report.achieved_parallelism.has_value()) {
+            cout << "[INFO] Achieved parallelism:      " << report.achieved_parallelism.value() << "x (last compile-project)" << endl;
+        }
+
+        cout << "[INFO] Projected with " << report.jobs << " job(s):   " << as_seconds(report.projected_compile_time) << " compile + " << as_seconds(report.link_time) << " link" << endl;
+
+        if (report.files_without_duration != 0) {
+            cout << "[WARN] " << report.files_without_duration << " file(s) have no recorded compilation time; figures are underestimated." << endl;
+        }
+
+        if (!report.costliest_headers.empty()) {
+            cout << endl << "[INFO] Costliest headers to modify (dependants, recompile time)" << endl;
+
+            for (const auto& header: report.costliest_headers) {
+                cout << std::right << std::setw(6) << header.dependants << std::setw(10) << as_seconds(header.recompile_time) << "  " << header.header << endl;
+            }
+        }
+
+        cout << std::defaultfloat;
+    }
+
+    void explain_rebuild(const string& file_name) {
+        const string file{ fs::path(file_name).lexically_normal().generic_string() };
+
+        const auto reasons{ workspace::modification_identifier::explain_rebuild(convert_cfg_to_model(), file) };
+
+        if (!reasons.has_value()) {
+            cout << "'" << file << "' is not part of the last recorded build! Run 'cbt compile-project' or 'cbt run-unit-tests' first." << endl;
+            return;
+        }
+
+        if (reasons.value().empty()) {
+            cout << "[INFO] '" << file << "' is up-to-date and will not be rebuilt." << endl;
+            return;
+        }
+
+        cout << "[INFO] '" << file << "' will be rebuilt because:" << endl;
+
+        for (const auto& reason: reasons.value()) {
+            cout << endl << "  - " << reason.description << endl;
+
+            for (std::size_t depth = 1; depth < reason.include_chain.size(); ++depth) {
+                cout << string(4 + 2 * depth, ' ') << "via #include " << reason.include_chain[depth] << endl;
+            }
+        }
+    }
+
+    void show_impact(const string& file_name, const unsigned int jobs) {
+        const string file{ fs::path(file_name).lexically_normal().generic_string() };
+
+        const std::optional<workspace::modification_identifier::RawDependencyTree> sources{ workspace::modification_identifier::load_dependency_graph("src") };
+
+        if (!sources.has_value()) {
+            cout << "No build recorded yet! Run 'cbt compile-project' first." << endl;
+            return;
+        }
+
+        const workspace::build_analysis::Impact impact{ workspace::build_analysis::analyse_impact(
+            file,
+            sources.value(),
+            workspace::modification_identifier::load_dependency_graph("tests/unit_tests").value_or(workspace::modification_identifier::RawDependencyTree{}),
+            workspace::modification_identifier::get_recorded_compilation_durations(),
+            workspace::build_analysis::load_durations(),
+            jobs
+        ) };
+
+        if (impact.dependants.empty()) {
+            cout << "[INFO] Nothing in the last recorded build depends on '" << file << "'." << endl;
+            return;
+        }
+
+        const auto as_seconds = [](const std::size_t milliseconds) {
+            std::ostringstream stream;
+            stream << std::fixed << std::setprecision(2) << (milliseconds / 1000.0) << "s";
+
+            return stream.str();
+        };
+
+        cout << "[INFO] Modifying '" << file << "' rebuilds " << impact.dependants.size() << " file(s)" << endl << endl;
+
+        for (const auto& dependant: impact.dependants) {
+            cout << std::right << std::setw(10) << (dependant.duration.has_value() ? as_seconds(dependant.duration.value()) : "?") << "  "
+                << (dependant.is_test_binary ? "[TEST] " : "") << dependant.name << endl;
         }
+
+        cout << endl
+            << "[INFO] Estimated rebuild time: " << as_seconds(impact.total_rebuild_time) << " of work, "
+            << as_seconds(impact.projected_rebuild_time) << " with " << impact.jobs << " job(s)" << endl;
     }
 
     void perform_static_analysis() {
@@ -475,6 +1800,7 @@ namespace commands {
             << "2. The '.env.template' file must be provided with all the environment values along with the necessary types" << endl
             << "3. `env` entry defaults to 'local.env' if no `env` entry is provided" << endl
             << "4. Specify the `env` file to be picked up without the '.env' extension, e.g. \"env=production\"" << endl
+            << "5. Set `CBT_TRACE=<file>` to record a Chrome trace (chrome://tracing, Perfetto) of every build phase and spawned process" << endl
             << endl
             << "Options:" << endl
             << endl
@@ -486,11 +1812,29 @@ namespace commands {
             << endl
             << "create-c-file <file_name>       - Generate respective C files under 'headers/c', 'src/c' and 'tests/unit_tests/c' directories (will create necessary sub-directories if required)" << endl
             << endl
+            << "create-benchmark <name>         - Generate a benchmark under 'tests/benchmarks/' directory (will create necessary sub-directories if required)" << endl
+            << endl
             << "resolve-dependencies            - Sync dependencies through 'project.cfg'" << endl
             << endl
             << "compile-project                 - Compile all files and generate respective binaries under 'build/binaries/'" << endl
             << "build-project                   - (For applications only) Perform linking and generate final executable under 'build/'" << endl
             << "run-unit-tests                  - Run all test cases under 'tests/unit_tests/' directory" << endl
+            << "  [--track-allocations]         - Report allocations, bytes and peak live bytes per test case" << endl
+            << "run-benchmarks                  - Build (with 'config{build_flags}') and run all benchmarks under 'tests/benchmarks/' directory" << endl
+            << "  [--compare=<baseline>]        - Fail if any benchmark regresses against the given baseline (e.g. 'latest')" << endl
+            << "  [--threshold=<percent>]       - Tolerated slowdown before a regression fails the run (defaults to 5)" << endl
+            << "  [--save=<baseline>]           - Additionally save the results under the given baseline name" << endl
+            << "  [--counters]                  - Collect hardware counters (instructions, cycles, cache and branch misses) on Linux" << endl
+            << "  [--track-allocations]         - Report allocations, bytes and peak live bytes per iteration" << endl
+            << endl
+            << "watch [compile|build|test]      - Rebuild on every change under 'headers/', 'src/' and 'tests/', then link or run affected tests" << endl
+            << "start-daemon                    - Keep a background server warm that serves 'compile-project', 'build-project' and 'run-unit-tests'" << endl
+            << "stop-daemon                     - Shut the background server down (it also does so on its own after 15 idle minutes)" << endl
+            << endl
+            << "analyse-build                   - Report the critical path, achievable parallelism and costliest headers from recorded timings" << endl
+            << "  [--jobs=<count>]              - Number of parallel jobs to project the build time for (defaults to the number of cores)" << endl
+            << "why <file>                      - Explain which changed input, through which include chain, makes a file rebuild" << endl
+            << "impact <file>                   - List every object and test binary a change to the file rebuilds, with estimated time" << endl
             << endl
             << "perform-static-analysis         - Invoke `cppcheck` with respective parameters from 'project.cfg'"  << endl
             << endl
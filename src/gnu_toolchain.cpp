@@ -3,10 +3,14 @@
 #include <numeric>
 #include <cstdlib>
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "workspace/linker.hpp"
 #include "workspace/project_config.hpp"
+#include "workspace/trace.hpp"
 
 namespace {
     using namespace gnu_toolchain;
@@ -43,47 +47,239 @@ namespace {
     }
 
     int execute(const std::string& cmd) {
-        return system(cmd.c_str());
+        const auto start{ workspace::trace::Clock::now() };
+        const int result{ system(cmd.c_str()) };
+
+        workspace::trace::record(cmd.substr(0, cmd.find(' ')), "process", start, workspace::trace::Clock::now(), 0, {
+            { "command", cmd },
+            { "exit_code", std::to_string(result) }
+        });
+
+        return result;
+    }
+
+    std::string get_allocation_tracking_flag(const bool track_allocations) {
+        return track_allocations ? " -DCBT_TRACK_ALLOCATIONS" : "";
+    }
+
+    // `-Winvalid-pch` explains why the compiler fell back to parsing the headers, e.g. after a flag changed
+    std::string get_precompiled_header_flags(const std::optional<std::string>& precompiled_header) {
+        return precompiled_header.has_value() ? " -Winvalid-pch -include " + precompiled_header.value() : "";
+    }
+
+    // Tells 'alloc_tracker.hpp' its allocation hooks come with the prebuilt test runtime rather than the test
+    std::string get_test_runtime_flags(const std::optional<std::string>& test_runtime_header) {
+        return test_runtime_header.has_value() ? " -DCBT_PREBUILT_TEST_RUNTIME" + get_precompiled_header_flags(test_runtime_header) : "";
+    }
+
+    // The last `-g` flag wins, `-g0` turning debug info back off
+    bool has_debug_info(const std::string& flags) {
+        std::istringstream stream(flags);
+        bool has_debug_info{ false };
+
+        for (std::string flag; stream >> flag;) {
+            if (flag.starts_with("-g")) {
+                has_debug_info = flag != "-g0";
+            }
+        }
+
+        return has_debug_info;
+    }
+
+    // `gold` cannot read '.dwo' files, so its `--gdb-index` relies on the names `-ggnu-pubnames` leaves in the objects
+    std::string get_debug_info_flags(const workspace::project_config::Project& project, const std::string& flags) {
+        if (!has_debug_info(flags)) {
+            return "";
+        }
+
+        return std::string(project.config.split_dwarf.value_or(false) ? " -gsplit-dwarf" : "") + (project.config.gdb_index.value_or(false) ? " -ggnu-pubnames" : "");
+    }
+
+    std::string get_linker_thread_flags(const std::string& linker) {
+        const unsigned int hardware_threads{ std::thread::hardware_concurrency() };
+
+        if (hardware_threads <= 1) {
+            return "";
+        }
+
+        const std::string threads{ std::to_string(hardware_threads) };
+
+        if (linker == "gold") {
+            return " -Wl,--threads -Wl,--thread-count=" + threads;
+        } else if (linker == "lld") {
+            return " -Wl,--threads=" + threads;
+        } else if (linker == "mold") {
+            return " -Wl,--thread-count=" + threads;
+        }
+
+        return "";
+    }
+
+    // 'bfd' has no `--gdb-index`, so the index brings in 'gold' unless another linker that has one is chosen
+    std::optional<std::string> resolve_linker(const workspace::project_config::Project& project) {
+        std::optional<std::string> linker{ workspace::linker::get_linker(project) };
+
+        if (project.config.gdb_index.value_or(false) && (!linker.has_value() || linker.value() == "bfd")) {
+            linker = "gold";
+        }
+
+        return linker;
+    }
+
+    // Options changing what the linker writes, as opposed to how fast it does
+    std::string get_linker_output_flags(const workspace::project_config::Project& project) {
+        return project.config.gdb_index.value_or(false) ? " -Wl,--gdb-index" : "";
+    }
+
+    // Position independent objects can end up in a shared library, e.g. 'libproject.so' for the tests
+    std::string get_compile_time_flags(const workspace::project_config::Project& project, const bool position_independent) {
+        return project.config.compile_time_flags + get_debug_info_flags(project, project.config.compile_time_flags) + (position_independent ? " -fPIC" : "");
+    }
+
+    // Relative to the binary, so that moving the project along with its build keeps it working
+    std::string get_runtime_search_path_flag(const std::optional<std::string>& library_directory) {
+        return library_directory.has_value() ? " -Wl,-rpath,'$ORIGIN/" + library_directory.value() + "'" : "";
+    }
+
+    std::string get_test_compilation_prefix(const workspace::project_config::Project& project, const bool track_allocations, const bool position_independent = false) {
+        return gnu_toolchain::COMPILER + " -std=" + project.config.cpp_standard + " " + project.config.safety_flags + " " + project.config.test_flags + get_debug_info_flags(project, project.config.test_flags) + get_allocation_tracking_flag(track_allocations) + (position_independent ? " -fPIC" : "") + " -pthread " + gnu_toolchain::INCLUDE_PATHS;
     }
 }
 
 namespace gnu_toolchain {
     using std::string;
 
+    string get_linker_flags(const workspace::project_config::Project& project) {
+        const std::optional<string> linker{ resolve_linker(project) };
+
+        if (!linker.has_value()) {
+            return "";
+        }
+
+        return " -fuse-ld=" + linker.value() + get_linker_thread_flags(linker.value()) + get_linker_output_flags(project);
+    }
+
+    string get_linker_signature(const workspace::project_config::Project& project) {
+        const std::optional<string> linker{ resolve_linker(project) };
+
+        if (!linker.has_value()) {
+            return "";
+        }
+
+        return " -fuse-ld=" + linker.value() + get_linker_output_flags(project);
+    }
+
+    int probe_linker(const string& linker) {
+        return execute(COMPILER + " -fuse-ld=" + linker + " -Wl,--version" + DISCARD_OUTPUT);
+    }
+
+    int write_toolchain_identity(const string& output_file) {
+        return execute(COMPILER + " -dumpfullversion > " + output_file + " && " + COMPILER + " -dumpmachine >> " + output_file);
+    }
+
     int generate_makefile(const workspace::project_config::Project& project, const string& files, const bool compile_as_dependency) {
         return execute(COMPILER + " -std=" + project.config.cpp_standard + " " + (compile_as_dependency ? INCLUDE_PATHS_FOR_DEPENDENCIES : INCLUDE_PATHS) + " -MM " + files + " >> .internals/tmp/makefile");
     }
 
-    std::string get_compilation_command(const workspace::project_config::Project& project, const bool compile_as_dependency) {
-        return COMPILER + " -std=" + project.config.cpp_standard + " " + project.config.safety_flags + " " + project.config.compile_time_flags + " " + (compile_as_dependency ? INCLUDE_PATHS_FOR_DEPENDENCIES : INCLUDE_PATHS) + " -c src/<FILE> -o build/binaries/<FILE>.o";
+    std::string get_compilation_command(const workspace::project_config::Project& project, const bool compile_as_dependency, const std::optional<string>& precompiled_header, const bool position_independent) {
+        return COMPILER + " -std=" + project.config.cpp_standard + " " + project.config.safety_flags + " " + get_compile_time_flags(project, position_independent) + " " + (compile_as_dependency ? INCLUDE_PATHS_FOR_DEPENDENCIES : INCLUDE_PATHS) + get_precompiled_header_flags(precompiled_header) + " -c src/<FILE> -o build/binaries/<FILE>.o";
+    }
+
+    string get_file_compilation_command(const workspace::project_config::Project& project, const string& input_file, const string& output_file, const bool compile_as_dependency, const std::optional<string>& precompiled_header, const bool position_independent) {
+        return COMPILER + " -std=" + project.config.cpp_standard + " " + project.config.safety_flags + " " + get_compile_time_flags(project, position_independent) + " " + (compile_as_dependency ? INCLUDE_PATHS_FOR_DEPENDENCIES : INCLUDE_PATHS) + get_precompiled_header_flags(precompiled_header) + " -c " + input_file + " -o build/binaries/" + output_file + ".o";
     }
 
-    int compile_file(const workspace::project_config::Project& project, const string& input_file, const string& output_file, const bool compile_as_dependency) {
-        return execute(COMPILER + " -std=" + project.config.cpp_standard + " " + project.config.safety_flags + " " + project.config.compile_time_flags + " " + (compile_as_dependency ? INCLUDE_PATHS_FOR_DEPENDENCIES : INCLUDE_PATHS) + " -c " + input_file + " -o build/binaries/" + output_file + ".o");
+    int compile_file(const workspace::project_config::Project& project, const string& input_file, const string& output_file, const bool compile_as_dependency, const std::optional<string>& precompiled_header, const bool position_independent) {
+        return execute(get_file_compilation_command(project, input_file, output_file, compile_as_dependency, precompiled_header, position_independent));
+    }
+
+    string get_module_unit_compilation_command(const workspace::project_config::Project& project, const string& input_file, const string& output_file, const string& module_mapper, const bool compile_as_dependency, const bool position_independent) {
+        // '-x c++' as 'g++' does not recognise '.cppm' files on its own
+        return COMPILER + " -std=" + project.config.cpp_standard + " " + project.config.safety_flags + " " + get_compile_time_flags(project, position_independent) + " " + (compile_as_dependency ? INCLUDE_PATHS_FOR_DEPENDENCIES : INCLUDE_PATHS) + " -fmodules-ts -fmodule-mapper=" + module_mapper + " -c -x c++ " + input_file + " -o build/binaries/" + output_file + ".o";
+    }
+
+    string get_batch_compilation_command(const workspace::project_config::Project& project, const string& batch_file, const string& output_file, const std::optional<string>& precompiled_header, const bool position_independent) {
+        return COMPILER + " -std=" + project.config.cpp_standard + " " + project.config.safety_flags + " " + get_compile_time_flags(project, position_independent) + " " + INCLUDE_PATHS + get_precompiled_header_flags(precompiled_header) + " -c " + batch_file + " -o " + output_file;
+    }
+
+    int precompile_header(const workspace::project_config::Project& project, const string& header, const string& output_file, const string& dependency_file, const bool compile_as_dependency, const bool position_independent) {
+        return execute(COMPILER + " -std=" + project.config.cpp_standard + " " + project.config.safety_flags + " " + get_compile_time_flags(project, position_independent) + " " + (compile_as_dependency ? INCLUDE_PATHS_FOR_DEPENDENCIES : INCLUDE_PATHS) + " -x c++-header " + header + " -o " + output_file + " -MMD -MF " + dependency_file);
+    }
+
+    int perform_linking(const workspace::project_config::Project& project, const std::vector<string>& directories_containing_binaries, const string& executable_file, const bool echo, const bool discard_output) {
+        const string command{ COMPILER + " -std=" + project.config.cpp_standard + " " + project.config.safety_flags + " " + project.config.build_flags + get_linker_flags(project) + " " + join(directories_containing_binaries, FoldType::BINARIES) + " -o " + executable_file };
+
+        if (echo) {
+            std::cout << "[COMMAND] " << command << std::endl << std::endl;
+        }
+
+        return execute(command + (discard_output ? DISCARD_OUTPUT : ""));
     }
 
-    int perform_linking(const workspace::project_config::Project& project, const std::vector<string>& directories_containing_binaries, const string& executable_file, const bool echo) {
-        const string command{ COMPILER + " -std=" + project.config.cpp_standard + " " + project.config.safety_flags + " " + project.config.build_flags + " " + join(directories_containing_binaries, FoldType::BINARIES) + " -o " + executable_file };
+    int perform_linking_of_objects(const workspace::project_config::Project& project, const std::vector<string>& objects, const string& executable_file, const bool echo, const bool discard_output) {
+        const string command{ COMPILER + " -std=" + project.config.cpp_standard + " " + project.config.safety_flags + " " + project.config.build_flags + get_linker_flags(project) + " " + join(objects, FoldType::PLAIN) + " -o " + executable_file };
 
         if (echo) {
             std::cout << "[COMMAND] " << command << std::endl << std::endl;
         }
 
-        return execute(command);
+        return execute(command + (discard_output ? DISCARD_OUTPUT : ""));
+    }
+
+    // Left to the default linker, which every toolchain can rely on to support `-r`
+    int create_relocatable_object(const std::vector<string>& objects, const string& output_file) {
+        return execute(COMPILER + " -r " + join(objects, FoldType::PLAIN) + " -o " + output_file);
+    }
+
+    string get_test_execution_command(const workspace::project_config::Project& project, const string& extension, const bool track_allocations, const std::optional<string>& test_runtime_header) {
+        return get_test_compilation_prefix(project, track_allocations) + get_test_runtime_flags(test_runtime_header) + get_linker_flags(project) + " tests/unit_tests/<FILE> -o build/test_binaries/unit_tests/<FILE>" + extension;
+    }
+
+    int precompile_test_runtime_header(const workspace::project_config::Project& project, const string& header, const string& output_file, const string& dependency_file, const bool track_allocations, const bool position_independent) {
+        return execute(get_test_compilation_prefix(project, track_allocations, position_independent) + " -DCBT_PREBUILT_TEST_RUNTIME -x c++-header " + header + " -o " + output_file + " -MMD -MF " + dependency_file);
+    }
+
+    int compile_test_runtime(const workspace::project_config::Project& project, const string& source_file, const string& output_file, const string& dependency_file, const bool track_allocations, const bool position_independent) {
+        return execute(get_test_compilation_prefix(project, track_allocations, position_independent) + " -c " + source_file + " -o " + output_file + " -MMD -MF " + dependency_file);
     }
 
-    string get_test_execution_command(const workspace::project_config::Project& project, const string& extension) {
-        return COMPILER + " -std=" + project.config.cpp_standard + " " + project.config.safety_flags + " " + project.config.test_flags + " " + INCLUDE_PATHS + " tests/unit_tests/<FILE> -o build/test_binaries/unit_tests/<FILE>" + extension;
+    int create_test_binary(const workspace::project_config::Project& project, const std::vector<string>& files_to_link, const string& test_binary, const bool track_allocations, const std::optional<string>& test_runtime_header, const std::optional<string>& library_directory) {
+        return execute(get_test_compilation_prefix(project, track_allocations) + get_test_runtime_flags(test_runtime_header) + get_linker_flags(project) + " " + join(files_to_link, FoldType::PLAIN) + get_runtime_search_path_flag(library_directory) + " -o " + test_binary);
     }
 
-    int create_test_binary(const workspace::project_config::Project& project, const std::vector<string>& files_to_link, const string& test_binary) {
-        return execute(COMPILER + " -std=" + project.config.cpp_standard + " " + project.config.safety_flags + " " + project.config.test_flags + " " + INCLUDE_PATHS + " " + join(files_to_link, FoldType::PLAIN) + " -o " + test_binary);
+    // Only objects compiled with '-fPIC' can be linked into it. `-Bsymbolic` binds references between its
+    // objects within the library, rather than to same-named definitions of the test binary loading it.
+    int create_shared_library(const workspace::project_config::Project& project, const std::vector<string>& objects, const std::vector<string>& libraries, const string& library) {
+        return execute(COMPILER + " -std=" + project.config.cpp_standard + " " + project.config.safety_flags + " " + project.config.test_flags + get_linker_flags(project) + " -shared -Wl,-Bsymbolic -Wl,-soname," + std::filesystem::path(library).filename().string() + " " + join(objects, FoldType::PLAIN) + (libraries.empty() ? "" : " " + join(libraries, FoldType::PLAIN)) + get_runtime_search_path_flag(".") + " -o " + library);
+    }
+
+    // `entry_point_header` renames the test's `main()`, and comes after the precompiled header as the latter is
+    // rejected when a macro it does not know of is defined. References to the project are left for the runner to resolve.
+    string get_test_shared_object_command(const workspace::project_config::Project& project, const string& entry_point_header, const bool track_allocations, const std::optional<string>& test_runtime_header) {
+        return get_test_compilation_prefix(project, track_allocations, true) + get_test_runtime_flags(test_runtime_header) + " -include " + entry_point_header + get_linker_flags(project) + " -shared tests/unit_tests/<FILE> -o build/test_binaries/unit_tests/<FILE>.so";
+    }
+
+    int create_test_shared_object(const workspace::project_config::Project& project, const string& test_file, const string& shared_object, const string& entry_point_header, const bool track_allocations, const std::optional<string>& test_runtime_header) {
+        return execute(get_test_compilation_prefix(project, track_allocations, true) + get_test_runtime_flags(test_runtime_header) + " -include " + entry_point_header + get_linker_flags(project) + " -shared " + test_file + " -o " + shared_object);
+    }
+
+    // `-rdynamic` exports the project's symbols to the test shared objects loaded at runtime
+    int create_test_runner(const workspace::project_config::Project& project, const string& runner_source, const std::vector<string>& files_to_link, const string& test_runner, const bool track_allocations) {
+        return execute(get_test_compilation_prefix(project, track_allocations) + get_linker_flags(project) + " -rdynamic " + runner_source + " " + join(files_to_link, FoldType::PLAIN) + " -ldl -o " + test_runner);
     }
 
     int execute_test_binary(const string& test_binary) {
         return execute(test_binary);
     }
 
+    string get_benchmark_execution_command(const workspace::project_config::Project& project, const string& extension, const bool track_allocations) {
+        return COMPILER + " -std=" + project.config.cpp_standard + " " + project.config.safety_flags + " " + project.config.build_flags + get_debug_info_flags(project, project.config.build_flags) + get_linker_flags(project) + get_allocation_tracking_flag(track_allocations) + " " + INCLUDE_PATHS + " tests/benchmarks/<FILE> -o build/test_binaries/benchmarks/<FILE>" + extension;
+    }
+
+    int create_benchmark_binary(const workspace::project_config::Project& project, const std::vector<string>& files_to_link, const string& benchmark_binary, const bool track_allocations) {
+        return execute(COMPILER + " -std=" + project.config.cpp_standard + " " + project.config.safety_flags + " " + project.config.build_flags + get_debug_info_flags(project, project.config.build_flags) + get_linker_flags(project) + get_allocation_tracking_flag(track_allocations) + " " + INCLUDE_PATHS + " " + join(files_to_link, FoldType::PLAIN) + " -o " + benchmark_binary);
+    }
+
     CompilerInfo get_compiler_info() {
         CompilerInfo compiler;
 
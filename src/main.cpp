@@ -1,15 +1,90 @@
 #include <cstdlib>
 #include <exception>
 #include <iostream>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
 #include "commands.hpp"
+#include "workspace/build_daemon.hpp"
+#include "workspace/job_scheduler.hpp"
 #include "workspace/scaffold.hpp"
 
+// Hands the command over to the workspace's daemon when one is running, otherwise it runs in-process
+bool is_served_by_daemon(const std::vector<std::string>& arguments) {
+    const std::optional<int> status{ workspace::build_daemon::forward(std::vector<std::string>(std::next(arguments.begin()), arguments.end())) };
+
+    if (status.has_value() && status.value() != EXIT_SUCCESS) {
+        std::exit(status.value());
+    }
+
+    return status.has_value();
+}
+
 void parse_commands_and_execute(std::vector<std::string>& arguments) {
     try {
-        if (arguments.size() == 3) {
+        if (arguments.size() >= 2 && arguments[1].compare("run-benchmarks") == 0) {
+            workspace::scaffold::exit_if_command_not_invoked_from_within_workspace();
+
+            std::optional<std::string> baseline_to_compare{ std::nullopt };
+            std::optional<std::string> baseline_to_save{ std::nullopt };
+            double threshold{ 5 };
+            bool collect_hardware_counters{ false };
+            bool track_allocations{ false };
+
+            for (auto argument = std::next(arguments.begin(), 2); argument != arguments.end(); ++argument) {
+                if (argument->starts_with("--compare=") && argument->length() > std::string("--compare=").length()) {
+                    baseline_to_compare = argument->substr(std::string("--compare=").length());
+                } else if (argument->starts_with("--save=") && argument->length() > std::string("--save=").length()) {
+                    baseline_to_save = argument->substr(std::string("--save=").length());
+                } else if (argument->starts_with("--threshold=")) {
+                    try {
+                        threshold = std::stod(argument->substr(std::string("--threshold=").length()));
+                    } catch (const std::exception&) {
+                        throw std::invalid_argument("Invalid threshold '" + *argument + "'");
+                    }
+                } else if (argument->compare("--counters") == 0) {
+                    collect_hardware_counters = true;
+                } else if (argument->compare("--track-allocations") == 0) {
+                    track_allocations = true;
+                } else {
+                    commands::show_usage();
+                    return;
+                }
+            }
+
+            commands::run_benchmarks(baseline_to_compare, baseline_to_save, threshold / 100, collect_hardware_counters, track_allocations);
+        } else if (arguments.size() >= 2 && arguments[1].compare("analyse-build") == 0) {
+            workspace::scaffold::exit_if_command_not_invoked_from_within_workspace();
+
+            unsigned int jobs{ workspace::job_scheduler::get_default_parallelism() };
+
+            for (auto argument = std::next(arguments.begin(), 2); argument != arguments.end(); ++argument) {
+                if (argument->starts_with("--jobs=")) {
+                    const std::string count{ argument->substr(std::string("--jobs=").length()) };
+                    std::size_t parsed_length{ 0 };
+                    long parsed_jobs{ 0 };
+
+                    try {
+                        parsed_jobs = std::stol(count, &parsed_length);
+                    } catch (const std::exception&) {}
+
+                    // Projecting a build onto no job at all would never finish it
+                    if (parsed_length == 0 || parsed_length != count.length() || parsed_jobs < 1) {
+                        throw std::invalid_argument("Invalid number of jobs '" + *argument + "'");
+                    }
+
+                    jobs = static_cast<unsigned int>(parsed_jobs);
+                } else {
+                    commands::show_usage();
+                    return;
+                }
+            }
+
+            commands::analyse_build(jobs);
+        } else if (arguments.size() == 3) {
             if (arguments[1].compare("create-application") == 0) {
                 commands::create_application(arguments[2]);
             } else if (arguments[1].compare("create-library") == 0) {
@@ -20,6 +95,24 @@ void parse_commands_and_execute(std::vector<std::string>& arguments) {
             } else if (arguments[1].compare("create-c-file") == 0) {
                 workspace::scaffold::exit_if_command_not_invoked_from_within_workspace();
                 commands::create_file(arguments[2], true);
+            } else if (arguments[1].compare("create-benchmark") == 0) {
+                workspace::scaffold::exit_if_command_not_invoked_from_within_workspace();
+                commands::create_benchmark(arguments[2]);
+            } else if (arguments[1].compare("run-unit-tests") == 0 && arguments[2].compare("--track-allocations") == 0) {
+                workspace::scaffold::exit_if_command_not_invoked_from_within_workspace();
+
+                if (!is_served_by_daemon(arguments)) {
+                    commands::run_unit_tests(true);
+                }
+            } else if (arguments[1].compare("watch") == 0 && (arguments[2].compare("compile") == 0 || arguments[2].compare("build") == 0 || arguments[2].compare("test") == 0)) {
+                workspace::scaffold::exit_if_command_not_invoked_from_within_workspace();
+                commands::watch(arguments[2]);
+            } else if (arguments[1].compare("why") == 0) {
+                workspace::scaffold::exit_if_command_not_invoked_from_within_workspace();
+                commands::explain_rebuild(arguments[2]);
+            } else if (arguments[1].compare("impact") == 0) {
+                workspace::scaffold::exit_if_command_not_invoked_from_within_workspace();
+                commands::show_impact(arguments[2], workspace::job_scheduler::get_default_parallelism());
             } else {
                 commands::show_usage();
             }
@@ -29,16 +122,34 @@ void parse_commands_and_execute(std::vector<std::string>& arguments) {
                 commands::resolve_dependencies();
             } else if (arguments[1].compare("compile-project") == 0) {
                 workspace::scaffold::exit_if_command_not_invoked_from_within_workspace();
-                commands::compile_project();
+
+                if (!is_served_by_daemon(arguments)) {
+                    commands::compile_project();
+                }
             } else if (arguments[1].compare("clear-build") == 0) {
                 workspace::scaffold::exit_if_command_not_invoked_from_within_workspace();
                 commands::clear_build();
             } else if (arguments[1].compare("build-project") == 0) {
                 workspace::scaffold::exit_if_command_not_invoked_from_within_workspace();
-                commands::build_project();
+
+                if (!is_served_by_daemon(arguments)) {
+                    commands::build_project();
+                }
             } else if (arguments[1].compare("run-unit-tests") == 0) {
                 workspace::scaffold::exit_if_command_not_invoked_from_within_workspace();
-                commands::run_unit_tests();
+
+                if (!is_served_by_daemon(arguments)) {
+                    commands::run_unit_tests();
+                }
+            } else if (arguments[1].compare("watch") == 0) {
+                workspace::scaffold::exit_if_command_not_invoked_from_within_workspace();
+                commands::watch("compile");
+            } else if (arguments[1].compare("start-daemon") == 0) {
+                workspace::scaffold::exit_if_command_not_invoked_from_within_workspace();
+                commands::start_daemon();
+            } else if (arguments[1].compare("stop-daemon") == 0) {
+                workspace::scaffold::exit_if_command_not_invoked_from_within_workspace();
+                commands::stop_daemon();
             } else if (arguments[1].compare("perform-static-analysis") == 0) {
                 workspace::scaffold::exit_if_command_not_invoked_from_within_workspace();
                 commands::perform_static_analysis();
@@ -0,0 +1,287 @@
+#include "workspace/benchmark_baseline.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gnu_toolchain.hpp"
+#include "workspace/util.hpp"
+
+namespace {
+    using namespace workspace::benchmark_baseline;
+
+    const string BASELINES_PATH{ ".internals/benchmarks" };
+
+    const string COMPILER_KEY{ "compiler" };
+    const string MACHINE_KEY{ "machine" };
+
+    // Significance level of the Mann-Whitney U test
+    const double ALPHA{ 0.05 };
+
+    // Coefficient of variation above which a benchmark is deemed too noisy to fail the gate
+    const double NOISE_THRESHOLD{ 0.1 };
+
+    fs::path get_baseline_file(const string& baseline, const string& benchmark) {
+        return fs::path(BASELINES_PATH) / baseline / (benchmark + ".txt");
+    }
+
+    // Lines are laid out as `iterations|sample,sample,...|counter=value;...|title`, while baselines recorded
+    // before the counters were collected lack that field
+    BenchmarkResult parse_result(const string& line) {
+        const auto first_delimiter{ line.find('|') };
+        const auto second_delimiter{ first_delimiter == string::npos ? string::npos : line.find('|', first_delimiter + 1) };
+
+        if (first_delimiter == string::npos || second_delimiter == string::npos) {
+            throw std::runtime_error("Malformed benchmark result '" + line + "'");
+        }
+
+        const auto found_delimiter{ line.find('|', second_delimiter + 1) };
+        const bool has_counters{ found_delimiter != string::npos };
+        const auto third_delimiter{ has_counters ? found_delimiter : second_delimiter };
+
+        BenchmarkResult result{
+            .title{ line.substr(third_delimiter + 1) },
+            .iterations{ std::stoull(line.substr(0, first_delimiter)) },
+            .samples{},
+            .counters{}
+        };
+
+        std::stringstream samples_stream(line.substr(first_delimiter + 1, second_delimiter - first_delimiter - 1));
+        string sample;
+
+        while (std::getline(samples_stream, sample, ',')) {
+            result.samples.push_back(std::stod(sample));
+        }
+
+        std::stringstream counters_stream(has_counters ? line.substr(second_delimiter + 1, third_delimiter - second_delimiter - 1) : "");
+        string counter;
+
+        while (std::getline(counters_stream, counter, ';')) {
+            const auto [name, value] = workspace::util::get_key_value_pair_from_line(counter, "=");
+            result.counters.push_back(std::make_tuple(name, std::stod(value)));
+        }
+
+        return result;
+    }
+
+    BenchmarkRecord read_record(const fs::path& file) {
+        std::ifstream record_file(file);
+        string line;
+
+        BenchmarkRecord record{};
+
+        while (std::getline(record_file, line)) {
+            std::erase(line, '\r');
+
+            if (line.empty() || line.starts_with(";")) {
+                continue;
+            }
+
+            const auto [key, value] = workspace::util::get_key_value_pair_from_line(line, "=");
+
+            if (key == COMPILER_KEY) {
+                record.compiler = value;
+            } else if (key == MACHINE_KEY) {
+                record.machine = value;
+            } else {
+                record.results.push_back(parse_result(line));
+            }
+        }
+
+        return record;
+    }
+
+    double median_of(std::vector<double> samples) {
+        std::sort(samples.begin(), samples.end());
+
+        const std::size_t count{ samples.size() };
+
+        return count % 2 == 0 ? (samples[count / 2 - 1] + samples[count / 2]) / 2 : samples[count / 2];
+    }
+
+    double coefficient_of_variation(const std::vector<double>& samples) {
+        const double mean{ std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size() };
+        double squared_deviations{ 0.0 };
+
+        for (const double sample: samples) {
+            squared_deviations += (sample - mean) * (sample - mean);
+        }
+
+        return samples.size() > 1 && mean > 0 ? std::sqrt(squared_deviations / (samples.size() - 1)) / mean : 0.0;
+    }
+
+    // Two-sided Mann-Whitney U test using the normal approximation with tie correction
+    double mann_whitney_p_value(const std::vector<double>& first, const std::vector<double>& second) {
+        const double n1 = first.size();
+        const double n2 = second.size();
+
+        std::vector<std::pair<double, int>> pooled;
+
+        for (const double sample: first) {
+            pooled.push_back({ sample, 0 });
+        }
+
+        for (const double sample: second) {
+            pooled.push_back({ sample, 1 });
+        }
+
+        std::sort(pooled.begin(), pooled.end());
+
+        double rank_sum_of_first{ 0.0 };
+        double tie_correction{ 0.0 };
+
+        for (std::size_t i = 0; i < pooled.size();) {
+            std::size_t j{ i };
+
+            while (j < pooled.size() && pooled[j].first == pooled[i].first) {
+                ++j;
+            }
+
+            const double ties = j - i;
+            const double average_rank{ (i + 1 + j) / 2.0 };
+
+            for (std::size_t k = i; k < j; ++k) {
+                if (pooled[k].second == 0) {
+                    rank_sum_of_first += average_rank;
+                }
+            }
+
+            tie_correction += ties * ties * ties - ties;
+            i = j;
+        }
+
+        const double u{ rank_sum_of_first - n1 * (n1 + 1) / 2 };
+        const double mean_u{ n1 * n2 / 2 };
+        const double n{ n1 + n2 };
+        const double variance_u{ n1 * n2 / 12 * ((n + 1) - tie_correction / (n * (n - 1))) };
+
+        if (variance_u <= 0) {
+            return 1.0;
+        }
+
+        const double z{ (std::abs(u - mean_u) - 0.5) / std::sqrt(variance_u) };
+
+        return std::erfc(std::max(z, 0.0) / std::sqrt(2.0));
+    }
+}
+
+namespace workspace::benchmark_baseline {
+    BenchmarkRecord parse_harness_output(const fs::path& output_file) {
+        const gnu_toolchain::CompilerInfo compiler{ gnu_toolchain::get_compiler_info() };
+
+        BenchmarkRecord record{ fs::exists(output_file) ? read_record(output_file) : BenchmarkRecord{} };
+
+        record.compiler = compiler.name + " " + compiler.version + " (" + compiler.platform + ")";
+        record.machine = workspace::util::get_machine_identity();
+
+        return record;
+    }
+
+    void persist(const string& baseline, const string& benchmark, const BenchmarkRecord& record) {
+        const fs::path baseline_file{ get_baseline_file(baseline, benchmark) };
+
+        fs::create_directories(baseline_file.parent_path());
+
+        std::ofstream file_to_write(baseline_file);
+
+        // Samples read back must compare exactly as they were measured
+        file_to_write << std::setprecision(std::numeric_limits<double>::max_digits10);
+
+        file_to_write << "; CBT generated. DO NOT EDIT!\n";
+        file_to_write << COMPILER_KEY << "=" << record.compiler << "\n";
+        file_to_write << MACHINE_KEY << "=" << record.machine << "\n";
+
+        for (const auto& result: record.results) {
+            file_to_write << result.iterations << "|";
+
+            for (std::size_t i = 0; i < result.samples.size(); ++i) {
+                file_to_write << (i == 0 ? "" : ",") << result.samples[i];
+            }
+
+            file_to_write << "|";
+
+            for (std::size_t i = 0; i < result.counters.size(); ++i) {
+                file_to_write << (i == 0 ? "" : ";") << std::get<0>(result.counters[i]) << "=" << std::get<1>(result.counters[i]);
+            }
+
+            file_to_write << "|" << result.title << "\n";
+        }
+
+        file_to_write.close();
+    }
+
+    std::optional<BenchmarkRecord> load(const string& baseline, const string& benchmark) {
+        const fs::path baseline_file{ get_baseline_file(baseline, benchmark) };
+
+        if (!fs::exists(baseline_file)) {
+            return std::nullopt;
+        }
+
+        return read_record(baseline_file);
+    }
+
+    Comparison compare(const std::optional<BenchmarkResult>& baseline, const BenchmarkResult& current, const double threshold) {
+        const double current_median{ median_of(current.samples) };
+
+        if (!baseline.has_value() || baseline->samples.empty()) {
+            return Comparison{ Verdict::NEW, 0.0, current_median, 1.0 };
+        }
+
+        const double baseline_median{ median_of(baseline->samples) };
+        const double p_value{ mann_whitney_p_value(baseline->samples, current.samples) };
+
+        const bool is_significant{ p_value < ALPHA };
+        const bool is_noisy{ coefficient_of_variation(baseline->samples) > NOISE_THRESHOLD || coefficient_of_variation(current.samples) > NOISE_THRESHOLD };
+
+        Verdict verdict{ Verdict::UNCHANGED };
+
+        if (is_significant && current_median > baseline_median * (1 + threshold)) {
+            verdict = is_noisy ? Verdict::NOISY : Verdict::REGRESSED;
+        } else if (is_significant && current_median < baseline_median * (1 - threshold)) {
+            verdict = Verdict::IMPROVED;
+        } else if (is_noisy) {
+            verdict = Verdict::NOISY;
+        }
+
+        return Comparison{ verdict, baseline_median, current_median, p_value };
+    }
+
+    string verdict_to_string(const Verdict& verdict) {
+        using enum workspace::benchmark_baseline::Verdict;
+
+        switch (verdict) {
+            case IMPROVED: return "[IMPROVED]";
+            case UNCHANGED: return "[OK]";
+            case REGRESSED: return "[REGRESSED]";
+            case NOISY: return "[NOISY]";
+            case NEW: return "[NEW]";
+            default: return "<unsupported>";
+        }
+    }
+
+    string describe_counter_changes(const BenchmarkResult& baseline, const BenchmarkResult& current) {
+        std::ostringstream description;
+        description << std::fixed << std::setprecision(2) << std::showpos;
+
+        for (const auto& [name, current_value]: current.counters) {
+            const auto it = std::ranges::find_if(baseline.counters, [&name](const auto& counter){ return std::get<0>(counter) == name; });
+
+            if (it == baseline.counters.end() || std::get<1>(*it) == 0) {
+                continue;
+            }
+
+            description << (description.tellp() == 0 ? "" : ", ") << name << " " << (current_value / std::get<1>(*it) - 1) * 100 << "%";
+        }
+
+        return description.str();
+    }
+}
@@ -0,0 +1,298 @@
+#include "workspace/build_analysis.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <optional>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "workspace/modification_identifier.hpp"
+
+namespace {
+    using namespace workspace::build_analysis;
+
+    namespace fs = std::filesystem;
+
+    using workspace::modification_identifier::RawDependencyTree;
+
+    const string DURATIONS_PATH{ ".internals/durations.txt" };
+
+    const std::size_t COSTLIEST_HEADERS_TO_REPORT{ 10 };
+
+    std::size_t get_duration(const Durations& durations, const string& step) {
+        const auto it = durations.find(step);
+
+        return it != durations.end() ? it->second : 0;
+    }
+
+    // 'headers/a/b.hpp' is implemented by 'src/a/b.cpp' and 'headers/c/d.h' by 'src/c/d.c'
+    string get_corresponding_implementation_file(const string& header) {
+        const fs::path implementation{ fs::path("src") / fs::path(header.substr(string("headers/").length())) };
+
+        return fs::path(implementation).replace_extension(header.ends_with(".h") ? ".c" : ".cpp").generic_string();
+    }
+
+    // Longest-processing-time-first list scheduling, which is what the compile scheduler approximates
+    std::size_t simulate_makespan(std::vector<std::size_t> durations, const unsigned int jobs) {
+        std::sort(durations.begin(), durations.end(), std::greater<>());
+
+        std::priority_queue<std::size_t, std::vector<std::size_t>, std::greater<>> slots;
+
+        for (unsigned int slot = 0; slot < std::max(1u, jobs); ++slot) {
+            slots.push(0);
+        }
+
+        std::size_t makespan{ 0 };
+
+        for (const std::size_t duration: durations) {
+            const std::size_t finish{ slots.top() + duration };
+
+            slots.pop();
+            slots.push(finish);
+
+            makespan = std::max(makespan, finish);
+        }
+
+        return makespan;
+    }
+}
+
+namespace workspace::build_analysis {
+    string get_test_compilation_step(const string& test_file) {
+        return "test_compile:" + test_file;
+    }
+
+    string get_test_execution_step(const string& test_file) {
+        return "test_run:" + test_file;
+    }
+
+    string get_compilation_without_precompiled_header_step(const string& file) {
+        return "compile_without_pch:" + file;
+    }
+
+    void record_durations(const Durations& durations) {
+        Durations merged_durations{ load_durations() };
+
+        for (const auto& [step, duration]: durations) {
+            merged_durations[step] = duration;
+        }
+
+        std::ofstream file_to_write(DURATIONS_PATH);
+
+        file_to_write << "; CBT generated. DO NOT EDIT!\n";
+
+        for (const auto& [step, duration]: merged_durations) {
+            file_to_write << step << "=" << duration << "\n";
+        }
+
+        file_to_write.close();
+    }
+
+    Durations load_durations() {
+        Durations durations{};
+
+        if (!fs::exists(DURATIONS_PATH)) {
+            return durations;
+        }
+
+        std::ifstream durations_file(DURATIONS_PATH);
+        string line;
+
+        while (std::getline(durations_file, line)) {
+            std::erase(line, '\r');
+
+            if (line.empty() || line.starts_with(";")) {
+                continue;
+            }
+
+            const auto separator{ line.rfind('=') };
+
+            if (separator != string::npos) {
+                durations[line.substr(0, separator)] = std::stoull(line.substr(separator + 1));
+            }
+        }
+
+        return durations;
+    }
+
+    Report analyse(
+        const RawDependencyTree& sources,
+        const RawDependencyTree& tests,
+        const Durations& compilation_durations,
+        const Durations& step_durations,
+        const unsigned int jobs
+    ) {
+        Report report{
+            .critical_path{},
+            .critical_path_length{ 0 },
+            .compile_work{ 0 },
+            .longest_compilation{ 0 },
+            .files_without_duration{ 0 },
+            .achieved_parallelism{ std::nullopt },
+            .theoretical_parallelism{ 1.0 },
+            .jobs{ jobs },
+            .projected_compile_time{ 0 },
+            .link_time{ get_duration(step_durations, LINK_STEP) },
+            .costliest_headers{}
+        };
+
+        std::vector<std::size_t> durations{};
+        string longest_file{};
+
+        for (const auto& [file, _]: sources) {
+            if (!compilation_durations.contains(file)) {
+                ++report.files_without_duration;
+            }
+
+            const std::size_t duration{ get_duration(compilation_durations, file) };
+
+            durations.push_back(duration);
+            report.compile_work += duration;
+
+            if (longest_file.empty() || duration > report.longest_compilation) {
+                report.longest_compilation = duration;
+                longest_file = file;
+            }
+        }
+
+        if (report.longest_compilation != 0) {
+            report.theoretical_parallelism = static_cast<double>(report.compile_work) / report.longest_compilation;
+        }
+
+        const std::size_t compile_wall_time{ get_duration(step_durations, COMPILE_WALL_TIME) };
+
+        if (compile_wall_time != 0) {
+            report.achieved_parallelism = static_cast<double>(get_duration(step_durations, COMPILE_WORK)) / compile_wall_time;
+        }
+
+        report.projected_compile_time = simulate_makespan(durations, jobs);
+
+        // With unbounded parallelism, linking waits for the slowest compilation, and a test binary for the
+        // slowest of the objects it links against
+        report.critical_path = { Step{ longest_file, report.longest_compilation }, Step{ LINK_STEP, report.link_time } };
+        report.critical_path_length = report.longest_compilation + report.link_time;
+
+        for (const auto& [test_file, dependencies]: tests) {
+            Step slowest_object{ "", 0 };
+
+            for (const auto& dependency: dependencies) {
+                const string implementation{ get_corresponding_implementation_file(dependency) };
+
+                if (sources.contains(implementation) && (slowest_object.name.empty() || get_duration(compilation_durations, implementation) > slowest_object.duration)) {
+                    slowest_object = Step{ implementation, get_duration(compilation_durations, implementation) };
+                }
+            }
+
+            const Step test_compilation{ get_test_compilation_step(test_file), get_duration(step_durations, get_test_compilation_step(test_file)) };
+            const Step test_execution{ get_test_execution_step(test_file), get_duration(step_durations, get_test_execution_step(test_file)) };
+
+            const std::size_t length{ slowest_object.duration + test_compilation.duration + test_execution.duration };
+
+            if (length > report.critical_path_length) {
+                report.critical_path = { test_compilation, test_execution };
+
+                if (!slowest_object.name.empty()) {
+                    report.critical_path.insert(report.critical_path.begin(), slowest_object);
+                }
+
+                report.critical_path_length = length;
+            }
+        }
+
+        // Every dependency listed by `g++ -MM` is transitive, so a header's dependants are exactly the files
+        // listing it
+        std::map<string, HeaderCost> header_costs{};
+
+        const auto account = [&header_costs](const string& header, const std::size_t cost) {
+            auto& header_cost{ header_costs.try_emplace(header, HeaderCost{ header, 0, 0 }).first->second };
+
+            ++header_cost.dependants;
+            header_cost.recompile_time += cost;
+        };
+
+        for (const auto& [file, dependencies]: sources) {
+            for (const auto& dependency: dependencies) {
+                account(dependency, get_duration(compilation_durations, file));
+            }
+        }
+
+        for (const auto& [test_file, dependencies]: tests) {
+            for (const auto& dependency: dependencies) {
+                account(dependency, get_duration(step_durations, get_test_compilation_step(test_file)));
+            }
+        }
+
+        for (const auto& [_, header_cost]: header_costs) {
+            report.costliest_headers.push_back(header_cost);
+        }
+
+        std::sort(report.costliest_headers.begin(), report.costliest_headers.end(), [](const HeaderCost& lhs, const HeaderCost& rhs) {
+            return lhs.recompile_time != rhs.recompile_time ? lhs.recompile_time > rhs.recompile_time : lhs.header < rhs.header;
+        });
+
+        if (report.costliest_headers.size() > COSTLIEST_HEADERS_TO_REPORT) {
+            report.costliest_headers.resize(COSTLIEST_HEADERS_TO_REPORT);
+        }
+
+        return report;
+    }
+
+    Impact analyse_impact(
+        const string& file,
+        const RawDependencyTree& sources,
+        const RawDependencyTree& tests,
+        const Durations& compilation_durations,
+        const Durations& step_durations,
+        const unsigned int jobs
+    ) {
+        Impact impact{ .dependants{}, .total_rebuild_time{ 0 }, .jobs{ jobs }, .projected_rebuild_time{ 0 } };
+
+        const auto is_dependant = [&file](const string& candidate, const std::vector<string>& dependencies) {
+            return candidate == file || std::find(dependencies.begin(), dependencies.end(), file) != dependencies.end();
+        };
+
+        const auto find_duration = [](const Durations& durations, const string& step) -> std::optional<std::size_t> {
+            const auto it = durations.find(step);
+
+            return it != durations.end() ? std::optional<std::size_t>{ it->second } : std::nullopt;
+        };
+
+        for (const auto& [source, dependencies]: sources) {
+            if (is_dependant(source, dependencies)) {
+                impact.dependants.push_back(Dependant{ source, false, find_duration(compilation_durations, source) });
+            }
+        }
+
+        for (const auto& [test, dependencies]: tests) {
+            if (is_dependant(test, dependencies)) {
+                impact.dependants.push_back(Dependant{ test, true, find_duration(step_durations, get_test_compilation_step(test)) });
+            }
+        }
+
+        std::sort(impact.dependants.begin(), impact.dependants.end(), [](const Dependant& lhs, const Dependant& rhs) {
+            return lhs.duration.value_or(0) != rhs.duration.value_or(0) ? lhs.duration.value_or(0) > rhs.duration.value_or(0) : lhs.name < rhs.name;
+        });
+
+        std::vector<std::size_t> object_durations{};
+        std::size_t test_binaries_time{ 0 };
+
+        for (const auto& dependant: impact.dependants) {
+            impact.total_rebuild_time += dependant.duration.value_or(0);
+
+            if (dependant.is_test_binary) {
+                test_binaries_time += dependant.duration.value_or(0);
+            } else {
+                object_durations.push_back(dependant.duration.value_or(0));
+            }
+        }
+
+        // Test binaries are built one after another, objects by the compile scheduler
+        impact.projected_rebuild_time = simulate_makespan(object_durations, jobs) + test_binaries_time;
+
+        return impact;
+    }
+}
@@ -0,0 +1,490 @@
+#include "workspace/build_daemon.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "workspace/jobserver.hpp"
+#include "workspace/trace.hpp"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    using namespace workspace::build_daemon;
+
+    #if !defined(_WIN32) && !defined(_WIN64)
+    namespace fs = std::filesystem;
+
+    const string RUN_REQUEST{ "run" };
+    const string STOP_REQUEST{ "stop" };
+
+    // Test binaries read their environment file from `env`, a trace of the request belongs wherever the
+    // client's `CBT_TRACE` points, and jobs draw on the jobserver the client's `MAKEFLAGS` advertises, so all
+    // of them have to be the client's
+    const std::vector<string> FORWARDED_VARIABLES{ "env", workspace::trace::OUTPUT_VARIABLE, "MAKEFLAGS" };
+
+    #if defined(MSG_NOSIGNAL)
+    const int SEND_FLAGS{ MSG_NOSIGNAL };
+    #else
+    const int SEND_FLAGS{ 0 };
+    #endif
+
+    // A request is framed as its length followed by NUL separated fields: the kind of request, the
+    // forwarded variables (each as 'name=value', empty if unset), then the arguments. Run requests carry the
+    // client's standard output and error as ancillary data, followed by the ends of its jobserver pipe if any.
+    struct Request {
+        std::vector<string> fields;
+        int output_fd;
+        int error_fd;
+        int jobserver_read_fd;
+        int jobserver_write_fd;
+    };
+
+    const std::size_t MAX_PASSED_FDS{ 4 };
+
+    sockaddr_un get_address() {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, SOCKET_PATH.c_str(), sizeof(address.sun_path) - 1);
+
+        return address;
+    }
+
+    void set_close_on_exec(const int fd) {
+        fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC);
+    }
+
+    std::optional<int> connect_to_daemon() {
+        const int fd{ socket(AF_UNIX, SOCK_STREAM, 0) };
+
+        if (fd < 0) {
+            return std::nullopt;
+        }
+
+        set_close_on_exec(fd);
+
+        #if defined(SO_NOSIGPIPE)
+        const int enabled{ 1 };
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &enabled, sizeof(enabled));
+        #endif
+
+        const sockaddr_un address{ get_address() };
+
+        if (connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            close(fd);
+            return std::nullopt;
+        }
+
+        return fd;
+    }
+
+    bool send_all(const int fd, const char* data, std::size_t length) {
+        while (length > 0) {
+            const ssize_t sent{ send(fd, data, length, SEND_FLAGS) };
+
+            if (sent < 0 && errno == EINTR) {
+                continue;
+            } else if (sent <= 0) {
+                return false;
+            }
+
+            data += sent;
+            length -= static_cast<std::size_t>(sent);
+        }
+
+        return true;
+    }
+
+    bool receive_all(const int fd, char* data, std::size_t length) {
+        while (length > 0) {
+            const ssize_t received{ recv(fd, data, length, 0) };
+
+            if (received < 0 && errno == EINTR) {
+                continue;
+            } else if (received <= 0) {
+                return false;
+            }
+
+            data += received;
+            length -= static_cast<std::size_t>(received);
+        }
+
+        return true;
+    }
+
+    bool send_request(const int fd, const std::vector<string>& fields, const std::vector<int>& passed_fds) {
+        string payload{};
+
+        for (const auto& field: fields) {
+            payload += field;
+            payload += '\0';
+        }
+
+        const std::uint32_t length{ static_cast<std::uint32_t>(payload.length()) };
+        payload.insert(0, reinterpret_cast<const char*>(&length), sizeof(length));
+
+        iovec io{ .iov_base = payload.data(), .iov_len = payload.length() };
+        alignas(cmsghdr) char control[CMSG_SPACE(MAX_PASSED_FDS * sizeof(int))]{};
+
+        msghdr message{};
+        message.msg_iov = &io;
+        message.msg_iovlen = 1;
+
+        if (!passed_fds.empty()) {
+            message.msg_control = control;
+            message.msg_controllen = CMSG_SPACE(passed_fds.size() * sizeof(int));
+
+            cmsghdr* header{ CMSG_FIRSTHDR(&message) };
+            header->cmsg_level = SOL_SOCKET;
+            header->cmsg_type = SCM_RIGHTS;
+            header->cmsg_len = CMSG_LEN(passed_fds.size() * sizeof(int));
+            std::memcpy(CMSG_DATA(header), passed_fds.data(), passed_fds.size() * sizeof(int));
+        }
+
+        ssize_t sent;
+
+        do {
+            sent = sendmsg(fd, &message, SEND_FLAGS);
+        } while (sent < 0 && errno == EINTR);
+
+        if (sent <= 0) {
+            return false;
+        }
+
+        return send_all(fd, payload.data() + sent, payload.length() - static_cast<std::size_t>(sent));
+    }
+
+    void close_passed_fds(const Request& request) {
+        for (const int descriptor: { request.output_fd, request.error_fd, request.jobserver_read_fd, request.jobserver_write_fd }) {
+            if (descriptor >= 0) {
+                close(descriptor);
+            }
+        }
+    }
+
+    std::optional<Request> receive_request(const int fd) {
+        std::uint32_t length{ 0 };
+        iovec io{ .iov_base = &length, .iov_len = sizeof(length) };
+        alignas(cmsghdr) char control[CMSG_SPACE(MAX_PASSED_FDS * sizeof(int))]{};
+
+        msghdr message{};
+        message.msg_iov = &io;
+        message.msg_iovlen = 1;
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+
+        // The descriptors arrive with the first byte, so the length prefix is read on its own
+        ssize_t received;
+
+        do {
+            received = recvmsg(fd, &message, MSG_WAITALL);
+        } while (received < 0 && errno == EINTR);
+
+        Request request{ .fields = {}, .output_fd = -1, .error_fd = -1, .jobserver_read_fd = -1, .jobserver_write_fd = -1 };
+
+        for (cmsghdr* header = CMSG_FIRSTHDR(&message); header != nullptr; header = CMSG_NXTHDR(&message, header)) {
+            if (header->cmsg_level == SOL_SOCKET && header->cmsg_type == SCM_RIGHTS
+                && (header->cmsg_len == CMSG_LEN(2 * sizeof(int)) || header->cmsg_len == CMSG_LEN(MAX_PASSED_FDS * sizeof(int)))
+            ) {
+                int fds[MAX_PASSED_FDS]{ -1, -1, -1, -1 };
+                std::memcpy(fds, CMSG_DATA(header), header->cmsg_len - CMSG_LEN(0));
+
+                request.output_fd = fds[0];
+                request.error_fd = fds[1];
+                request.jobserver_read_fd = fds[2];
+                request.jobserver_write_fd = fds[3];
+            }
+        }
+
+        string payload(length, '\0');
+
+        if (received != static_cast<ssize_t>(sizeof(length)) || !receive_all(fd, payload.data(), payload.length())) {
+            close_passed_fds(request);
+
+            return std::nullopt;
+        }
+
+        for (std::size_t start = 0, end; (end = payload.find('\0', start)) != string::npos; start = end + 1) {
+            request.fields.push_back(payload.substr(start, end - start));
+        }
+
+        return request;
+    }
+
+    void send_status(const int fd, const int status) {
+        const std::int32_t code{ status };
+        send_all(fd, reinterpret_cast<const char*>(&code), sizeof(code));
+    }
+
+    void flush_standard_streams() {
+        std::cout.flush();
+        std::cerr.flush();
+        std::fflush(nullptr);
+    }
+
+    void set_forwarded_variables(const std::vector<string>& fields) {
+        for (std::size_t i = 0; i < FORWARDED_VARIABLES.size(); ++i) {
+            const string& variable{ FORWARDED_VARIABLES[i] };
+
+            if (fields[i].starts_with(variable + "=")) {
+                setenv(variable.c_str(), fields[i].substr(variable.length() + 1).c_str(), 1);
+            } else {
+                unsetenv(variable.c_str());
+            }
+        }
+    }
+
+    int run(const Request& request, const Handler& handler) {
+        if (request.fields.size() < 1 + FORWARDED_VARIABLES.size() || request.output_fd < 0 || request.error_fd < 0) {
+            return EXIT_FAILURE;
+        }
+
+        flush_standard_streams();
+
+        const int saved_output_fd{ dup(STDOUT_FILENO) };
+        const int saved_error_fd{ dup(STDERR_FILENO) };
+
+        // Whatever the handler spawns inherits the client's streams as well
+        dup2(request.output_fd, STDOUT_FILENO);
+        dup2(request.error_fd, STDERR_FILENO);
+
+        set_forwarded_variables(std::vector<string>(request.fields.begin() + 1, request.fields.begin() + 1 + FORWARDED_VARIABLES.size()));
+        // The client's pipe is known here by other descriptors, if it was passed down to the client at all
+        workspace::jobserver::readvertise_pipe(request.jobserver_read_fd, request.jobserver_write_fd);
+        workspace::trace::restart();
+
+        int status{ EXIT_SUCCESS };
+
+        try {
+            handler(std::vector<string>(request.fields.begin() + 1 + FORWARDED_VARIABLES.size(), request.fields.end()));
+        } catch (const std::exception& e) {
+            std::cerr << "Exception: " << e.what() << std::endl << std::endl;
+            status = EXIT_FAILURE;
+        } catch (...) {
+            std::cerr << "Something went wrong!" << std::endl << std::endl;
+            status = EXIT_FAILURE;
+        }
+
+        workspace::trace::finish();
+        // The next request may come from another 'make', or from none at all
+        workspace::jobserver::reset();
+        flush_standard_streams();
+
+        dup2(saved_output_fd, STDOUT_FILENO);
+        dup2(saved_error_fd, STDERR_FILENO);
+        close(saved_output_fd);
+        close(saved_error_fd);
+
+        return status;
+    }
+
+    void serve(const int listening_fd, const Handler& handler) {
+        const int timeout{ static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(IDLE_TIMEOUT).count()) };
+
+        while (true) {
+            pollfd descriptor{ .fd = listening_fd, .events = POLLIN, .revents = 0 };
+            const int ready{ poll(&descriptor, 1, timeout) };
+
+            if (ready < 0 && errno == EINTR) {
+                continue;
+            } else if (ready <= 0) {
+                return;
+            }
+
+            const int client_fd{ accept(listening_fd, nullptr, nullptr) };
+
+            if (client_fd < 0) {
+                continue;
+            }
+
+            set_close_on_exec(client_fd);
+
+            // Probes from `is_running()` connect and hang up without a request
+            const std::optional<Request> request{ receive_request(client_fd) };
+
+            if (!request.has_value() || request->fields.empty()) {
+                close(client_fd);
+                continue;
+            }
+
+            const bool is_stop_request{ request->fields.front() == STOP_REQUEST };
+
+            send_status(client_fd, is_stop_request ? EXIT_SUCCESS : run(request.value(), handler));
+
+            close_passed_fds(request.value());
+            close(client_fd);
+
+            if (is_stop_request) {
+                return;
+            }
+        }
+    }
+    #endif
+}
+
+namespace workspace::build_daemon {
+    #if !defined(_WIN32) && !defined(_WIN64)
+    std::optional<int> forward(const std::vector<string>& arguments) {
+        const std::optional<int> fd{ connect_to_daemon() };
+
+        if (!fd.has_value()) {
+            return std::nullopt;
+        }
+
+        std::vector<string> fields{ RUN_REQUEST };
+
+        for (const auto& variable: FORWARDED_VARIABLES) {
+            const char* value{ std::getenv(variable.c_str()) };
+            fields.push_back(value == nullptr ? "" : variable + "=" + value);
+        }
+
+        fields.insert(fields.end(), arguments.begin(), arguments.end());
+
+        std::vector<int> passed_fds{ STDOUT_FILENO, STDERR_FILENO };
+
+        if (const auto jobserver_pipe = workspace::jobserver::find_advertised_pipe(); jobserver_pipe.has_value()) {
+            passed_fds.push_back(std::get<0>(jobserver_pipe.value()));
+            passed_fds.push_back(std::get<1>(jobserver_pipe.value()));
+        }
+
+        flush_standard_streams();
+
+        // Nothing has run yet if the request could not be sent, e.g. the daemon shut down in between
+        if (!send_request(fd.value(), fields, passed_fds)) {
+            close(fd.value());
+            return std::nullopt;
+        }
+
+        std::int32_t status{ EXIT_FAILURE };
+
+        if (!receive_all(fd.value(), reinterpret_cast<char*>(&status), sizeof(status))) {
+            std::cerr << "[WARN] The daemon exited before completing the request" << std::endl;
+            status = EXIT_FAILURE;
+        }
+
+        close(fd.value());
+
+        return status;
+    }
+
+    int start(const Handler& handler) {
+        if (is_running()) {
+            throw std::runtime_error("A daemon is already running for this workspace!");
+        }
+
+        fs::create_directories(fs::path(SOCKET_PATH).parent_path());
+        // Left behind by a daemon that did not shut down cleanly
+        fs::remove(SOCKET_PATH);
+
+        const int listening_fd{ socket(AF_UNIX, SOCK_STREAM, 0) };
+        const sockaddr_un address{ get_address() };
+
+        if (listening_fd < 0 || bind(listening_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || listen(listening_fd, 16) != 0) {
+            throw std::runtime_error("Could not listen on '" + SOCKET_PATH + "': " + std::strerror(errno));
+        }
+
+        set_close_on_exec(listening_fd);
+
+        struct stat socket_status{};
+        stat(SOCKET_PATH.c_str(), &socket_status);
+
+        flush_standard_streams();
+
+        const pid_t pid{ fork() };
+
+        if (pid < 0) {
+            close(listening_fd);
+            throw std::runtime_error("Could not start the daemon!");
+        } else if (pid > 0) {
+            close(listening_fd);
+            return static_cast<int>(pid);
+        }
+
+        // Detach from the terminal, so closing it does not take the daemon along
+        setsid();
+        std::signal(SIGPIPE, SIG_IGN);
+
+        // Whatever the parent recorded is its own to write out, not the daemon's at exit
+        unsetenv(workspace::trace::OUTPUT_VARIABLE.c_str());
+        workspace::trace::restart();
+
+        if (const int null_fd = open("/dev/null", O_RDWR); null_fd >= 0) {
+            for (const int fd: { STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO }) {
+                dup2(null_fd, fd);
+            }
+
+            close(null_fd);
+        }
+
+        serve(listening_fd, handler);
+
+        close(listening_fd);
+
+        // A successor may have replaced the socket in the meantime
+        if (struct stat current{}; stat(SOCKET_PATH.c_str(), &current) == 0 && current.st_ino == socket_status.st_ino && current.st_dev == socket_status.st_dev) {
+            unlink(SOCKET_PATH.c_str());
+        }
+
+        std::exit(EXIT_SUCCESS);
+    }
+
+    bool stop() {
+        const std::optional<int> fd{ connect_to_daemon() };
+
+        if (!fd.has_value()) {
+            return false;
+        }
+
+        std::int32_t status{ EXIT_FAILURE };
+        const bool is_stopped{ send_request(fd.value(), { STOP_REQUEST, "" }, {}) && receive_all(fd.value(), reinterpret_cast<char*>(&status), sizeof(status)) };
+
+        close(fd.value());
+
+        return is_stopped;
+    }
+
+    bool is_running() {
+        const std::optional<int> fd{ connect_to_daemon() };
+
+        if (fd.has_value()) {
+            close(fd.value());
+        }
+
+        return fd.has_value();
+    }
+    #else
+    std::optional<int> forward(const std::vector<string>&) {
+        return std::nullopt;
+    }
+
+    int start(const Handler&) {
+        throw std::runtime_error("The build daemon is not supported on Windows!");
+    }
+
+    bool stop() {
+        return false;
+    }
+
+    bool is_running() {
+        return false;
+    }
+    #endif
+}
@@ -0,0 +1,196 @@
+#include "workspace/cpp_modules.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    using namespace workspace::cpp_modules;
+
+    namespace fs = std::filesystem;
+
+    const string MAPPER_NAME{ "mapper.txt" };
+
+    string read_file(const fs::path& path) {
+        std::ifstream stream(path, std::ios::binary);
+        std::ostringstream content;
+        content << stream.rdbuf();
+
+        return content.str();
+    }
+
+    // Module declarations and imports have to start their line, so a line based scan suffices for the code
+    // cbt generates and reviews; block comments are not looked into
+    Unit scan_file(const string& file) {
+        static const std::regex module_declaration{ R"re(^\s*(export\s+)?module\s+([\w.]+)(:[\w.]+)?\s*;)re" };
+        static const std::regex module_import{ R"re(^\s*(export\s+)?import\s+([\w.]+|:[\w.]+)\s*;)re" };
+        static const std::regex header_unit_import{ R"re(^\s*(export\s+)?import\s*[<"])re" };
+
+        Unit unit{ .file{ file }, .provided_module{ std::nullopt }, .required_modules{} };
+        string module_name{};
+
+        std::ifstream stream(file);
+
+        for (string line; std::getline(stream, line); ) {
+            line = line.substr(0, line.find("//"));
+
+            if (std::smatch match; std::regex_search(line, match, module_declaration)) {
+                module_name = match[2].str();
+
+                if (match[1].matched || match[3].matched) {
+                    unit.provided_module = module_name + match[3].str();
+                } else {
+                    unit.required_modules.push_back(module_name);
+                }
+            } else if (std::regex_search(line, match, module_import)) {
+                const string imported{ match[2].str() };
+
+                if (imported.starts_with(":") && module_name.empty()) {
+                    throw std::runtime_error("Partition '" + imported + "' imported outside of a module in '" + file + "'");
+                }
+
+                unit.required_modules.push_back(imported.starts_with(":") ? module_name + imported : imported);
+            } else if (std::regex_search(line, header_unit_import)) {
+                throw std::runtime_error("Header units are not supported, use '#include' instead (in '" + file + "')");
+            }
+        }
+
+        return unit;
+    }
+}
+
+namespace workspace::cpp_modules {
+    bool is_module_interface(const string& file) {
+        return file.ends_with(MODULE_INTERFACE_EXTENSION);
+    }
+
+    std::vector<Unit> scan(const std::vector<string>& files) {
+        std::vector<Unit> units{};
+
+        for (const auto& file: files) {
+            if (Unit unit = scan_file(file); unit.provided_module.has_value() || !unit.required_modules.empty()) {
+                units.push_back(unit);
+            } else if (is_module_interface(file)) {
+                throw std::runtime_error("Module interface '" + file + "' does not declare a module");
+            }
+        }
+
+        return units;
+    }
+
+    std::map<string, std::vector<string>> get_providers(const std::vector<Unit>& units) {
+        std::map<string, string> providers{};
+
+        for (const auto& unit: units) {
+            if (!unit.provided_module.has_value()) {
+                continue;
+            }
+
+            if (const auto [it, is_inserted] = providers.emplace(unit.provided_module.value(), unit.file); !is_inserted) {
+                throw std::runtime_error("Module '" + unit.provided_module.value() + "' is provided by both '" + it->second + "' and '" + unit.file + "'");
+            }
+        }
+
+        std::map<string, std::vector<string>> prerequisites{};
+
+        for (const auto& unit: units) {
+            std::vector<string>& files{ prerequisites[unit.file] };
+
+            for (const auto& module: unit.required_modules) {
+                const auto provider{ providers.find(module) };
+
+                if (provider == providers.end()) {
+                    throw std::runtime_error("Module '" + module + "' imported by '" + unit.file + "' is not provided by any '" + MODULE_INTERFACE_EXTENSION + "' file");
+                }
+
+                files.push_back(provider->second);
+            }
+        }
+
+        // Depth-first search, with files on the current path marked as being visited
+        std::map<string, bool> is_being_visited{};
+
+        const std::function<void(const string&)> visit = [&](const string& file) {
+            if (const auto it = is_being_visited.find(file); it != is_being_visited.end()) {
+                if (it->second) {
+                    throw std::runtime_error("Module imports form a cycle through '" + file + "'");
+                }
+
+                return;
+            }
+
+            is_being_visited[file] = true;
+
+            for (const auto& provider: prerequisites[file]) {
+                visit(provider);
+            }
+
+            is_being_visited[file] = false;
+        };
+
+        for (const auto& unit: units) {
+            visit(unit.file);
+        }
+
+        return prerequisites;
+    }
+
+    std::set<string> list_importers(const std::vector<Unit>& units, const std::set<string>& files) {
+        const std::map<string, std::vector<string>> providers{ get_providers(units) };
+
+        std::set<string> importers{};
+        std::vector<string> queue(files.begin(), files.end());
+
+        while (!queue.empty()) {
+            const string file{ queue.back() };
+            queue.pop_back();
+
+            for (const auto& [importer, importer_providers]: providers) {
+                if (std::ranges::find(importer_providers, file) != importer_providers.end() && importers.insert(importer).second) {
+                    queue.push_back(importer);
+                }
+            }
+        }
+
+        return importers;
+    }
+
+    string get_bmi_directory(const string& compilation_command) {
+        std::ostringstream key;
+        key << std::hex << std::hash<string>{}(compilation_command);
+
+        return MODULES_PATH + "/" + key.str();
+    }
+
+    string get_bmi(const string& bmi_directory, const string& module) {
+        return bmi_directory + "/" + module + ".gcm";
+    }
+
+    string write_module_mapper(const std::vector<Unit>& units, const string& bmi_directory) {
+        // Relative paths in the mapper are resolved against '$root', and a dependency compiles from its own directory
+        string content{ "$root " + fs::current_path().generic_string() + "\n" };
+
+        for (const auto& unit: units) {
+            if (unit.provided_module.has_value()) {
+                content += unit.provided_module.value() + " " + get_bmi(bmi_directory, unit.provided_module.value()) + "\n";
+            }
+        }
+
+        const fs::path mapper{ fs::path(bmi_directory) / MAPPER_NAME };
+
+        if (!fs::exists(mapper) || read_file(mapper) != content) {
+            fs::create_directories(bmi_directory);
+            std::ofstream(mapper, std::ios::binary) << content;
+        }
+
+        return mapper.generic_string();
+    }
+}
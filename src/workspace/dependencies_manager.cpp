@@ -12,6 +12,7 @@
 
 #include "workspace/project_config.hpp"
 #include "workspace/scaffold.hpp"
+#include "workspace/trace.hpp"
 #include "workspace/util.hpp"
 #include "commands.hpp"
 
@@ -66,12 +67,22 @@ namespace {
 
         std::cout << "[EXECUTE] " << download_command << "\n\n";
 
-        if (system(download_command.c_str()) == 0) {
+        const auto download_start{ workspace::trace::Clock::now() };
+        const int download_result{ system(download_command.c_str()) };
+
+        workspace::trace::record("download " + versioned_name, "process", download_start, workspace::trace::Clock::now(), 0, { { "command", download_command } });
+
+        if (download_result == 0) {
             std::cout << "\n[EXECUTE] " << extract_command << "\n\n";
 
             fs::create_directory(extracted_directory);
             
-            if (system(extract_command.c_str()) == 0) {
+            const auto extract_start{ workspace::trace::Clock::now() };
+            const int extract_result{ system(extract_command.c_str()) };
+
+            workspace::trace::record("extract " + versioned_name, "process", extract_start, workspace::trace::Clock::now(), 0, { { "command", extract_command } });
+
+            if (extract_result == 0) {
                 project = get_project_information(extracted_directory);
 
                 if (project.name != dependency.name || project.version != dependency.version) {
@@ -177,7 +188,7 @@ namespace {
         }
     }
 
-    int compile_uncompiled_dependencies(const SurfaceDependencies& resolved_dependencies) {
+    int compile_uncompiled_dependencies(const SurfaceDependencies& resolved_dependencies, const bool position_independent) {
         fs::path project_root{ fs::current_path() };
         int compiled_dependencies_count{ 0 };
 
@@ -193,7 +204,7 @@ namespace {
 
                 std::cout << "[DEPENDENCY] " << versioned_name << "\n\n";
 
-                commands::compile_project(true);
+                commands::compile_project(true, position_independent);
 
                 std::cout << "\n";
 
@@ -247,6 +258,8 @@ namespace {
 
 namespace workspace::dependencies_manager {
     void resolve_dependencies(const Project& project) {
+        const workspace::trace::Span span{ "resolve_dependencies" };
+
         Projects locally_stored_dependencies = list_all_dependencies_available_locally();
 
         std::map<SurfaceDependency, int, SurfaceDependencyComparator> dependency_frequency;
@@ -258,7 +271,7 @@ namespace workspace::dependencies_manager {
         remove_unnecessary_dependencies(resolved_dependencies, locally_stored_dependencies);
         create_header_symlinks(resolved_dependencies);
 
-        const int compiled_dependencies_count{ compile_uncompiled_dependencies(resolved_dependencies) };
+        const int compiled_dependencies_count{ compile_uncompiled_dependencies(resolved_dependencies, project.config.shared_test_libraries.value_or(false)) };
 
         if (compiled_dependencies_count == 0) {
             if (project.dependencies.empty() && resolved_dependencies.empty()) {
@@ -0,0 +1,138 @@
+#include "workspace/dependency_graph.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+    using namespace workspace::dependency_graph;
+
+    Adjacency construct_adjacency(const std::size_t nodes, const std::vector<std::pair<NodeId, NodeId>>& edges, const bool transpose) {
+        Adjacency adjacency{ .offsets = std::vector<std::uint32_t>(nodes + 1, 0), .targets = std::vector<NodeId>(edges.size()) };
+
+        for (const auto& [from, to]: edges) {
+            ++adjacency.offsets[(transpose ? to : from) + 1];
+        }
+
+        for (std::size_t node = 0; node < nodes; ++node) {
+            adjacency.offsets[node + 1] += adjacency.offsets[node];
+        }
+
+        std::vector<std::uint32_t> cursors(adjacency.offsets.begin(), adjacency.offsets.end() - 1);
+
+        for (const auto& [from, to]: edges) {
+            adjacency.targets[cursors[transpose ? to : from]++] = (transpose ? from : to);
+        }
+
+        return adjacency;
+    }
+}
+
+namespace workspace::dependency_graph {
+    PathTable::PathTable(const PathTable& another_table): paths{ another_table.paths }, ids{} {
+        for (NodeId node = 0; node < paths.size(); ++node) {
+            ids.emplace(std::string_view(paths[node]), node);
+        }
+    }
+
+    PathTable& PathTable::operator=(const PathTable& another_table) {
+        if (this != &another_table) {
+            *this = PathTable(another_table);
+        }
+
+        return *this;
+    }
+
+    NodeId intern(PathTable& table, const std::string_view path) {
+        if (const auto it = table.ids.find(path); it != table.ids.end()) {
+            return it->second;
+        }
+
+        if (table.paths.size() >= UINT32_MAX) {
+            throw std::length_error("Too many files in the dependency graph!");
+        }
+
+        const NodeId node{ static_cast<NodeId>(table.paths.size()) };
+
+        table.ids.emplace(std::string_view(table.paths.emplace_back(path)), node);
+
+        return node;
+    }
+
+    std::optional<NodeId> find(const PathTable& table, const std::string_view path) {
+        if (const auto it = table.ids.find(path); it != table.ids.end()) {
+            return it->second;
+        }
+
+        return std::nullopt;
+    }
+
+    NodeId add_translation_unit(Builder& builder, const std::string_view file) {
+        const NodeId node{ intern(builder.table, file) };
+
+        builder.translation_units.push_back(node);
+
+        return node;
+    }
+
+    void add_include(Builder& builder, const NodeId file, const std::string_view header) {
+        builder.edges.emplace_back(file, intern(builder.table, header));
+    }
+
+    Graph build(Builder&& builder) {
+        const std::size_t nodes{ builder.table.paths.size() };
+
+        Graph graph{
+            .table{ std::move(builder.table) },
+            .translation_units{ std::move(builder.translation_units) },
+            .includes{ construct_adjacency(nodes, builder.edges, false) },
+            .dependants{ construct_adjacency(nodes, builder.edges, true) }
+        };
+
+        builder.edges.clear();
+        builder.edges.shrink_to_fit();
+
+        return graph;
+    }
+
+    std::size_t size(const Graph& graph) {
+        return graph.table.paths.size();
+    }
+
+    const string& get_path(const Graph& graph, const NodeId node) {
+        return graph.table.paths[node];
+    }
+
+    std::span<const NodeId> get_neighbours(const Adjacency& adjacency, const NodeId node) {
+        return std::span<const NodeId>(adjacency.targets).subspan(adjacency.offsets[node], adjacency.offsets[node + 1] - adjacency.offsets[node]);
+    }
+
+    NodeSet propagate_dirty(const Graph& graph, NodeSet dirty) {
+        std::vector<NodeId> frontier{};
+
+        for (NodeId node = 0; node < dirty.size(); ++node) {
+            if (dirty[node]) {
+                frontier.push_back(node);
+            }
+        }
+
+        while (!frontier.empty()) {
+            const NodeId node{ frontier.back() };
+            frontier.pop_back();
+
+            for (const NodeId dependant: get_neighbours(graph.dependants, node)) {
+                if (!dirty[dependant]) {
+                    dirty[dependant] = true;
+                    frontier.push_back(dependant);
+                }
+            }
+        }
+
+        return dirty;
+    }
+}
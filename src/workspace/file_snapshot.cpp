@@ -0,0 +1,323 @@
+#include "workspace/file_snapshot.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "workspace/trace.hpp"
+
+namespace {
+    using namespace workspace::file_snapshot;
+
+    namespace cr = std::chrono;
+
+    const std::vector<string> ROOTS{ "headers", "src", "tests", "build", "dependencies" };
+
+    const unsigned int MAX_WALKERS{ 8 };
+
+    struct Snapshot {
+        std::unordered_map<string, Entry> entries;
+        // Sorted entries directly under each directory
+        std::unordered_map<string, std::vector<string>> children;
+        std::set<string> walked_roots;
+    };
+
+    struct Walk {
+        std::mutex mutex;
+        std::condition_variable wakeup;
+
+        std::deque<string> pending_directories;
+        std::size_t busy_walkers{ 0 };
+
+        Snapshot& snapshot;
+    };
+
+    std::size_t to_milliseconds(const fs::file_time_type& time) {
+        return static_cast<std::size_t>(cr::duration_cast<cr::milliseconds>(time.time_since_epoch()).count());
+    }
+
+    std::optional<Entry> stat_directly(const fs::path& path) {
+        std::error_code error;
+
+        const fs::file_status status{ fs::status(path, error) };
+
+        if (error || !fs::exists(status)) {
+            return std::nullopt;
+        }
+
+        const fs::file_time_type last_write_time{ fs::last_write_time(path, error) };
+
+        return Entry{
+            .is_directory{ fs::is_directory(status) },
+            .is_symlink{ fs::is_symlink(fs::symlink_status(path, error)) },
+            .last_modified_timestamp{ error ? 0 : to_milliseconds(last_write_time) }
+        };
+    }
+
+    // 'build/', './build' and 'build' are the same key; absolute paths and those leaving the working directory
+    // have none
+    std::optional<string> normalise(const fs::path& path) {
+        string normalised{ path.lexically_normal().generic_string() };
+
+        while (normalised.ends_with("/") && normalised.length() > 1) {
+            normalised.pop_back();
+        }
+
+        if (normalised.empty() || normalised == "." || normalised.starts_with("..") || path.is_absolute() || path.has_root_name()) {
+            return std::nullopt;
+        }
+
+        return normalised;
+    }
+
+    std::optional<string> get_snapshotted_root(const string& normalised) {
+        const string root{ normalised.substr(0, normalised.find('/')) };
+
+        return std::find(ROOTS.begin(), ROOTS.end(), root) != ROOTS.end() ? std::optional<string>{ root } : std::nullopt;
+    }
+
+    void walk_directories(Walk& walk) {
+        std::unique_lock lock(walk.mutex);
+
+        while (true) {
+            walk.wakeup.wait(lock, [&walk]() { return !walk.pending_directories.empty() || walk.busy_walkers == 0; });
+
+            if (walk.pending_directories.empty()) {
+                return;
+            }
+
+            const string directory{ walk.pending_directories.front() };
+            walk.pending_directories.pop_front();
+            ++walk.busy_walkers;
+
+            lock.unlock();
+
+            std::vector<std::pair<string, Entry>> entries{};
+            std::vector<string> subdirectories{};
+            std::error_code error;
+
+            for (auto it = fs::directory_iterator(directory, error); !error && it != fs::directory_iterator(); it.increment(error)) {
+                std::error_code entry_error;
+
+                const bool is_symlink{ it->is_symlink(entry_error) };
+                const bool is_directory{ it->is_directory(entry_error) };
+                const fs::file_time_type last_write_time{ it->last_write_time(entry_error) };
+
+                // Dangling symbolic links don't exist as far as `std::filesystem::exists` is concerned
+                if (entry_error) {
+                    continue;
+                }
+
+                const string path{ directory + "/" + it->path().filename().generic_string() };
+
+                entries.emplace_back(path, Entry{ .is_directory{ is_directory }, .is_symlink{ is_symlink }, .last_modified_timestamp{ to_milliseconds(last_write_time) } });
+
+                if (is_directory && !is_symlink) {
+                    subdirectories.push_back(path);
+                }
+            }
+
+            lock.lock();
+
+            std::vector<string>& children{ walk.snapshot.children[directory] };
+
+            for (auto& [path, entry]: entries) {
+                children.push_back(path);
+                walk.snapshot.entries.emplace(std::move(path), entry);
+            }
+
+            std::sort(children.begin(), children.end());
+
+            walk.pending_directories.insert(walk.pending_directories.end(), subdirectories.begin(), subdirectories.end());
+            --walk.busy_walkers;
+
+            walk.wakeup.notify_all();
+        }
+    }
+
+    void take_snapshot(Snapshot& snapshot, const string& root) {
+        const workspace::trace::Span span{ "take_file_snapshot", { { "root", root } } };
+
+        Walk walk{ .mutex{}, .wakeup{}, .pending_directories{}, .busy_walkers{ 0 }, .snapshot{ snapshot } };
+
+        snapshot.walked_roots.insert(root);
+
+        if (const auto entry{ stat_directly(root) }; entry.has_value()) {
+            snapshot.entries[root] = entry.value();
+
+            if (entry.value().is_directory && !entry.value().is_symlink) {
+                walk.pending_directories.push_back(root);
+            }
+        }
+
+        const unsigned int walkers{ std::clamp(std::thread::hardware_concurrency(), 1u, MAX_WALKERS) };
+        std::vector<std::thread> threads{};
+
+        for (unsigned int walker = 1; walker < walkers; ++walker) {
+            threads.emplace_back(walk_directories, std::ref(walk));
+        }
+
+        walk_directories(walk);
+
+        for (auto& thread: threads) {
+            thread.join();
+        }
+    }
+
+    // Working directories to their snapshots, each root being walked the first time it's queried
+    Snapshot& get_snapshot(const string& root) {
+        static std::map<fs::path, Snapshot> snapshots{};
+
+        Snapshot& snapshot{ snapshots[fs::current_path()] };
+
+        if (!snapshot.walked_roots.contains(root)) {
+            take_snapshot(snapshot, root);
+        }
+
+        return snapshot;
+    }
+}
+
+namespace workspace::file_snapshot {
+    std::optional<Entry> lookup(const fs::path& path) {
+        const std::optional<string> normalised{ normalise(path) };
+        const std::optional<string> root{ normalised.has_value() ? get_snapshotted_root(normalised.value()) : std::nullopt };
+
+        if (!root.has_value()) {
+            return stat_directly(path);
+        }
+
+        const Snapshot& snapshot{ get_snapshot(root.value()) };
+
+        if (const auto it = snapshot.entries.find(normalised.value()); it != snapshot.entries.end()) {
+            return it->second;
+        }
+
+        // Symbolic links aren't followed while walking, so what lies beneath one is unknown rather than missing
+        for (fs::path parent = fs::path(normalised.value()).parent_path(); !parent.empty(); parent = parent.parent_path()) {
+            if (const auto it = snapshot.entries.find(parent.generic_string()); it != snapshot.entries.end()) {
+                return it->second.is_symlink ? stat_directly(path) : std::nullopt;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    bool is_free_of_symlinks(const fs::path& path) {
+        const std::optional<string> normalised{ normalise(path) };
+        const std::optional<string> root{ normalised.has_value() ? get_snapshotted_root(normalised.value()) : std::nullopt };
+
+        if (!root.has_value()) {
+            return false;
+        }
+
+        const Snapshot& snapshot{ get_snapshot(root.value()) };
+        const auto it = snapshot.entries.find(normalised.value());
+
+        return it != snapshot.entries.end() && !it->second.is_symlink;
+    }
+
+    bool exists(const fs::path& path) {
+        return lookup(path).has_value();
+    }
+
+    bool is_directory(const fs::path& path) {
+        const std::optional<Entry> entry{ lookup(path) };
+
+        return entry.has_value() && entry.value().is_directory;
+    }
+
+    std::size_t get_last_modified_timestamp(const fs::path& path) {
+        const std::optional<Entry> entry{ lookup(path) };
+
+        if (!entry.has_value()) {
+            throw fs::filesystem_error("Cannot get file time", path, std::make_error_code(std::errc::no_such_file_or_directory));
+        }
+
+        return entry.value().last_modified_timestamp;
+    }
+
+    std::vector<string> list_directory(const fs::path& directory) {
+        const std::optional<string> normalised{ normalise(directory) };
+        const std::optional<Entry> entry{ lookup(directory) };
+
+        if (!entry.has_value() || !entry.value().is_directory) {
+            return {};
+        }
+
+        // Every directory walked has its (possibly empty) list, those beneath symbolic links don't
+        if (const std::optional<string> root{ normalised.has_value() ? get_snapshotted_root(normalised.value()) : std::nullopt }; root.has_value()) {
+            const Snapshot& snapshot{ get_snapshot(root.value()) };
+
+            if (const auto it = snapshot.children.find(normalised.value()); it != snapshot.children.end()) {
+                return it->second;
+            }
+        }
+
+        std::vector<string> children{};
+
+        for (const auto& child: fs::directory_iterator(directory)) {
+            children.push_back(child.path().generic_string());
+        }
+
+        std::sort(children.begin(), children.end());
+
+        return children;
+    }
+
+    std::vector<string> list_directory_recursively(const fs::path& directory) {
+        std::vector<string> entries{};
+        std::vector<string> pending_directories{ directory.generic_string() };
+
+        while (!pending_directories.empty()) {
+            const string current{ pending_directories.back() };
+            pending_directories.pop_back();
+
+            for (const auto& child: list_directory(current)) {
+                entries.push_back(child);
+
+                // Like `std::filesystem::recursive_directory_iterator`, symbolic links to directories aren't entered
+                if (const std::optional<Entry> entry{ lookup(child) }; entry.has_value() && entry.value().is_directory && !entry.value().is_symlink) {
+                    pending_directories.push_back(child);
+                }
+            }
+        }
+
+        std::sort(entries.begin(), entries.end());
+
+        return entries;
+    }
+
+    void invalidate(const string& path) {
+        const std::optional<string> normalised{ normalise(path) };
+        const std::optional<string> root{ normalised.has_value() ? get_snapshotted_root(normalised.value()) : std::nullopt };
+
+        if (!root.has_value()) {
+            return;
+        }
+
+        Snapshot& snapshot{ get_snapshot(root.value()) };
+
+        const auto is_under_root = [&root](const auto& entry) {
+            return entry.first == root.value() || entry.first.starts_with(root.value() + "/");
+        };
+
+        std::erase_if(snapshot.entries, is_under_root);
+        std::erase_if(snapshot.children, is_under_root);
+
+        snapshot.walked_roots.erase(root.value());
+    }
+}
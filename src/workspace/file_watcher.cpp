@@ -0,0 +1,253 @@
+#include "workspace/file_watcher.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    using namespace workspace::file_watcher;
+
+    namespace fs = std::filesystem;
+
+    // Editors' swap and backup files come and go with every save, so only files cbt builds from are reported
+    bool is_relevant(const string& path) {
+        return path.ends_with(".cpp") || path.ends_with(".cppm") || path.ends_with(".hpp") || path.ends_with(".c") || path.ends_with(".h") || fs::path(path).filename() == "project.cfg";
+    }
+
+    #if defined(__linux__)
+    const std::uint32_t WATCHED_EVENTS{ IN_CLOSE_WRITE | IN_ATTRIB | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF };
+
+    int inotify_fd{ -1 };
+
+    // Watch descriptors to the directories they watch, and the files watched on their own in those
+    // directories (everything is reported there if empty)
+    std::map<int, string> watched_directories{};
+    std::map<string, std::set<string>> watched_files{};
+
+    void watch_directory(const string& directory, std::set<string>& changes, const bool report_existing_files) {
+        const int descriptor{ inotify_add_watch(inotify_fd, directory.c_str(), WATCHED_EVENTS) };
+
+        if (descriptor < 0) {
+            return;
+        }
+
+        watched_directories[descriptor] = directory;
+
+        std::error_code error;
+
+        for (auto it = fs::directory_iterator(directory, error); !error && it != fs::directory_iterator(); it.increment(error)) {
+            const string path{ directory + "/" + it->path().filename().string() };
+
+            if (it->is_directory(error) && !it->is_symlink(error)) {
+                watch_directory(path, changes, report_existing_files);
+            } else if (report_existing_files && is_relevant(path)) {
+                // Files created in a new directory before it was watched would otherwise go unnoticed
+                changes.insert(path);
+            }
+        }
+    }
+
+    void initialise(const std::vector<string>& paths) {
+        if (inotify_fd >= 0) {
+            return;
+        }
+
+        inotify_fd = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+
+        if (inotify_fd < 0) {
+            throw std::runtime_error("Could not initialise inotify!");
+        }
+
+        std::set<string> ignored_changes{};
+
+        for (const auto& path: paths) {
+            if (fs::is_directory(path)) {
+                watch_directory(path, ignored_changes, false);
+            } else {
+                const fs::path parent{ fs::path(path).parent_path() };
+                const string directory{ parent.empty() ? "." : parent.generic_string() };
+                const int descriptor{ inotify_add_watch(inotify_fd, directory.c_str(), WATCHED_EVENTS) };
+
+                if (descriptor >= 0) {
+                    watched_directories[descriptor] = directory;
+                    watched_files[directory].insert(fs::path(path).filename().string());
+                }
+            }
+        }
+    }
+
+    // Returns whether anything was read within `timeout`, `-1` blocking indefinitely
+    bool read_events(std::set<string>& changes, const int timeout) {
+        pollfd descriptor{ .fd = inotify_fd, .events = POLLIN, .revents = 0 };
+
+        if (poll(&descriptor, 1, timeout) <= 0) {
+            return false;
+        }
+
+        alignas(inotify_event) char buffer[64 * 1024];
+        bool has_read{ false };
+
+        while (true) {
+            const ssize_t length{ read(inotify_fd, buffer, sizeof(buffer)) };
+
+            if (length <= 0) {
+                return has_read;
+            }
+
+            has_read = true;
+
+            for (ssize_t offset = 0; offset < length; ) {
+                const auto* event{ reinterpret_cast<const inotify_event*>(buffer + offset) };
+                offset += sizeof(inotify_event) + event->len;
+
+                const auto watched{ watched_directories.find(event->wd) };
+
+                if (watched == watched_directories.end()) {
+                    continue;
+                }
+
+                if ((event->mask & (IN_DELETE_SELF | IN_IGNORED)) != 0) {
+                    watched_directories.erase(watched);
+                    continue;
+                }
+
+                if (event->len == 0) {
+                    continue;
+                }
+
+                const string directory{ watched->second };
+                const string name{ event->name };
+                const string path{ directory == "." ? name : directory + "/" + name };
+
+                if (const auto files = watched_files.find(directory); files != watched_files.end() && !files->second.contains(name)) {
+                    continue;
+                }
+
+                if ((event->mask & IN_ISDIR) != 0) {
+                    if ((event->mask & (IN_CREATE | IN_MOVED_TO)) != 0) {
+                        watch_directory(path, changes, true);
+                    }
+
+                    // A directory going away takes its files along, which the build notices by their absence
+                    changes.insert(path);
+                } else if (is_relevant(path)) {
+                    changes.insert(path);
+                }
+            }
+        }
+    }
+    #else
+    std::map<string, fs::file_time_type> last_seen{};
+
+    std::map<string, fs::file_time_type> take_inventory(const std::vector<string>& paths) {
+        std::map<string, fs::file_time_type> inventory{};
+        std::error_code error;
+
+        for (const auto& path: paths) {
+            if (fs::is_directory(path, error)) {
+                for (auto it = fs::recursive_directory_iterator(path, error); !error && it != fs::recursive_directory_iterator(); it.increment(error)) {
+                    const string file{ it->path().generic_string() };
+
+                    if (it->is_regular_file(error) && is_relevant(file)) {
+                        inventory[file] = it->last_write_time(error);
+                    }
+                }
+            } else if (fs::exists(path, error)) {
+                inventory[path] = fs::last_write_time(path, error);
+            }
+        }
+
+        return inventory;
+    }
+
+    std::set<string> compare_inventory(const std::vector<string>& paths) {
+        const std::map<string, fs::file_time_type> inventory{ take_inventory(paths) };
+        std::set<string> changes{};
+
+        for (const auto& [file, last_write_time]: inventory) {
+            if (const auto it = last_seen.find(file); it == last_seen.end() || it->second != last_write_time) {
+                changes.insert(file);
+            }
+        }
+
+        for (const auto& [file, _]: last_seen) {
+            if (!inventory.contains(file)) {
+                changes.insert(file);
+            }
+        }
+
+        last_seen = inventory;
+
+        return changes;
+    }
+    #endif
+}
+
+namespace workspace::file_watcher {
+    std::vector<string> wait_for_changes(const std::vector<string>& paths, const std::chrono::milliseconds quiet_period) {
+        std::set<string> changes{};
+
+        #if defined(__linux__)
+        initialise(paths);
+
+        while (changes.empty()) {
+            read_events(changes, -1);
+        }
+
+        // Every batch arriving within the quiet period extends it
+        while (read_events(changes, static_cast<int>(quiet_period.count()))) {
+            continue;
+        }
+        #else
+        if (last_seen.empty()) {
+            last_seen = take_inventory(paths);
+        }
+
+        while (changes.empty()) {
+            std::this_thread::sleep_for(quiet_period);
+            changes = compare_inventory(paths);
+        }
+
+        for (std::set<string> burst{ changes }; !burst.empty(); changes.insert(burst.begin(), burst.end())) {
+            std::this_thread::sleep_for(quiet_period);
+            burst = compare_inventory(paths);
+        }
+        #endif
+
+        return std::vector<string>(changes.begin(), changes.end());
+    }
+
+    std::vector<string> poll_changes(const std::vector<string>& paths) {
+        std::set<string> changes{};
+
+        #if defined(__linux__)
+        initialise(paths);
+
+        while (read_events(changes, 0)) {
+            continue;
+        }
+        #else
+        if (last_seen.empty()) {
+            last_seen = take_inventory(paths);
+        } else {
+            changes = compare_inventory(paths);
+        }
+        #endif
+
+        return std::vector<string>(changes.begin(), changes.end());
+    }
+}
@@ -0,0 +1,246 @@
+#include "workspace/job_scheduler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "workspace/jobserver.hpp"
+#include "workspace/trace.hpp"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    using namespace workspace::job_scheduler;
+
+    // Upper bound on how late a finished job is noticed while waiting for a jobserver token
+    const std::chrono::milliseconds TOKEN_POLL_INTERVAL{ 10 };
+
+    enum class State {
+        PENDING,
+        RUNNING,
+        SUCCEEDED,
+        FAILED
+    };
+
+    #if !defined(_WIN32) && !defined(_WIN64)
+    pid_t spawn(const string& command) {
+        // Anything still buffered would otherwise be duplicated into the child
+        std::cout.flush();
+
+        const pid_t pid = fork();
+
+        if (pid == 0) {
+            execl("/bin/sh", "sh", "-c", command.c_str(), static_cast<char*>(nullptr));
+            _exit(127);
+        }
+
+        if (pid < 0) {
+            throw std::runtime_error("Could not spawn '" + command + "'");
+        }
+
+        return pid;
+    }
+
+    int to_exit_code(const int status) {
+        return WIFEXITED(status) ? WEXITSTATUS(status) : EXIT_FAILURE;
+    }
+
+    std::size_t to_bytes(const struct rusage& usage) {
+        #if defined(__APPLE__)
+        return static_cast<std::size_t>(usage.ru_maxrss);
+        #else
+        return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+        #endif
+    }
+    #endif
+}
+
+namespace workspace::job_scheduler {
+    unsigned int get_default_parallelism() {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    void run(const std::vector<Job>& jobs, const Limits& limits, const OnStart& on_start, const OnCompletion& on_completion) {
+        std::vector<State> states(jobs.size(), State::PENDING);
+        std::size_t first_pending{ 0 };
+
+        // Jobs whose prerequisites failed complete right away without running, so the next job returned is
+        // the first one in order that can run, if any
+        const auto find_ready_job = [&]() -> std::optional<std::size_t> {
+            while (first_pending < jobs.size() && states[first_pending] != State::PENDING) {
+                ++first_pending;
+            }
+
+            for (std::size_t job = first_pending; job < jobs.size(); ) {
+                if (states[job] != State::PENDING) {
+                    ++job;
+                    continue;
+                }
+
+                const auto& prerequisites{ jobs[job].prerequisites };
+
+                if (std::ranges::any_of(prerequisites, [&states](const std::size_t prerequisite) { return states[prerequisite] == State::FAILED; })) {
+                    states[job] = State::FAILED;
+
+                    on_start(job);
+                    on_completion(job, Outcome{ .exit_code{ EXIT_FAILURE }, .peak_memory{ 0 }, .was_skipped{ true } });
+
+                    // Its own dependants may come before it
+                    job = first_pending;
+                    continue;
+                }
+
+                if (std::ranges::all_of(prerequisites, [&states](const std::size_t prerequisite) { return states[prerequisite] == State::SUCCEEDED; })) {
+                    return job;
+                }
+
+                ++job;
+            }
+
+            return std::nullopt;
+        };
+
+        const auto has_pending_jobs = [&]() {
+            return std::ranges::find(states, State::PENDING) != states.end();
+        };
+
+        #if defined(_WIN32) || defined(_WIN64)
+        (void)limits;
+
+        while (const std::optional<std::size_t> ready = find_ready_job()) {
+            const std::size_t job{ ready.value() };
+
+            on_start(job);
+
+            const auto start{ workspace::trace::Clock::now() };
+            const int exit_code{ std::system(jobs[job].command.c_str()) };
+
+            workspace::trace::record(jobs[job].label, "job", start, workspace::trace::Clock::now(), 1, {
+                { "command", jobs[job].command },
+                { "slot", "0" },
+                { "exit_code", std::to_string(exit_code) }
+            });
+
+            states[job] = exit_code == 0 ? State::SUCCEEDED : State::FAILED;
+            on_completion(job, Outcome{ .exit_code{ exit_code }, .peak_memory{ 0 }, .was_skipped{ false } });
+        }
+
+        if (has_pending_jobs()) {
+            throw std::runtime_error("Job prerequisites form a cycle");
+        }
+        #else
+        const workspace::jobserver::Role jobserver_role{ workspace::jobserver::initialise(std::max(1u, limits.parallelism)) };
+
+        struct RunningJob {
+            std::size_t job;
+            unsigned int slot;
+            workspace::trace::Clock::time_point start;
+        };
+
+        std::map<pid_t, RunningJob> running{};
+        std::set<unsigned int> occupied_slots{};
+        std::size_t reserved_memory{ 0 };
+
+        const auto is_within_limits = [&](const Job& job) {
+            if (running.empty()) {
+                return true;
+            }
+
+            const bool within_parallelism{ running.size() < std::max(1u, limits.parallelism) };
+            const bool within_memory_budget{ limits.memory_budget == 0 || reserved_memory + job.expected_memory <= limits.memory_budget };
+
+            return within_parallelism && within_memory_budget;
+        };
+
+        // The first job in flight runs on the implicit slot, every other one holds a jobserver token
+        const auto can_admit = [&](const Job& job) {
+            return is_within_limits(job) && (running.empty() || workspace::jobserver::try_acquire());
+        };
+
+        while (has_pending_jobs() || !running.empty()) {
+            std::optional<std::size_t> next_job{ find_ready_job() };
+
+            while (next_job.has_value() && can_admit(jobs[next_job.value()])) {
+                const std::size_t job{ next_job.value() };
+                unsigned int slot{ 0 };
+
+                while (occupied_slots.contains(slot)) {
+                    ++slot;
+                }
+
+                on_start(job);
+
+                const auto start{ workspace::trace::Clock::now() };
+
+                running[spawn(jobs[job].command)] = RunningJob{ .job{ job }, .slot{ slot }, .start{ start } };
+                occupied_slots.insert(slot);
+                reserved_memory += jobs[job].expected_memory;
+                states[job] = State::RUNNING;
+
+                next_job = find_ready_job();
+            }
+
+            if (running.empty()) {
+                if (has_pending_jobs()) {
+                    throw std::runtime_error("Job prerequisites form a cycle");
+                }
+
+                break;
+            }
+
+            // Only block on the children when a free token would not let another job start anyway, which is
+            // always the case without a jobserver to hand out tokens
+            const bool is_waiting_for_token{ jobserver_role != workspace::jobserver::Role::UNAVAILABLE && next_job.has_value() && is_within_limits(jobs[next_job.value()]) };
+
+            int status{ 0 };
+            struct rusage usage{};
+            const pid_t pid = wait4(-1, &status, is_waiting_for_token ? WNOHANG : 0, &usage);
+
+            if (pid == 0) {
+                workspace::jobserver::wait_for_token(TOKEN_POLL_INTERVAL);
+                continue;
+            }
+
+            if (pid < 0) {
+                throw std::runtime_error("Lost track of running jobs");
+            }
+
+            if (const auto it = running.find(pid); it != running.end()) {
+                const auto [job, slot, start] = it->second;
+                const Outcome outcome{ .exit_code{ to_exit_code(status) }, .peak_memory{ to_bytes(usage) }, .was_skipped{ false } };
+
+                running.erase(it);
+                occupied_slots.erase(slot);
+                reserved_memory -= jobs[job].expected_memory;
+                states[job] = outcome.exit_code == 0 ? State::SUCCEEDED : State::FAILED;
+
+                if (!running.empty()) {
+                    workspace::jobserver::release();
+                }
+
+                workspace::trace::record(jobs[job].label, "job", start, workspace::trace::Clock::now(), slot + 1, {
+                    { "command", jobs[job].command },
+                    { "slot", std::to_string(slot) },
+                    { "exit_code", std::to_string(outcome.exit_code) },
+                    { "peak_memory", std::to_string(outcome.peak_memory) }
+                });
+
+                on_completion(job, outcome);
+            }
+        }
+        #endif
+    }
+}
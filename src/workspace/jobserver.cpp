@@ -0,0 +1,281 @@
+#include "workspace/jobserver.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "workspace/util.hpp"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    using namespace workspace::jobserver;
+
+    using std::string;
+
+    const char TOKEN{ '+' };
+
+    std::optional<Role> role{ std::nullopt };
+
+    // Reads are non-blocking on a private open file description, writes go to the shared one
+    int read_fd{ -1 };
+    int write_fd{ -1 };
+
+    // Descriptors opened here rather than inherited, which `reset` closes
+    std::vector<int> owned_fds{};
+
+    #if !defined(_WIN32) && !defined(_WIN64)
+    bool is_open(const int fd) {
+        return fd >= 0 && fcntl(fd, F_GETFD) != -1;
+    }
+
+    // Setting `O_NONBLOCK` on an inherited descriptor would leak into every other process sharing it,
+    // so reopen the pipe where the platform allows; otherwise fall back to polling before each read
+    int open_private_reader(const int fd) {
+        #if defined(__linux__)
+        const int private_fd = open(("/proc/self/fd/" + std::to_string(fd)).c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+
+        if (private_fd >= 0) {
+            return private_fd;
+        }
+        #endif
+
+        return fd;
+    }
+
+    // Where the value of the jobserver option starts and ends in `flags`
+    std::optional<std::tuple<std::size_t, std::size_t>> find_jobserver_auth(const string& flags) {
+        // Last occurrence wins, `--jobserver-fds` being the spelling of GNU make prior to 4.2
+        for (const string option: { "--jobserver-auth=", "--jobserver-fds=" }) {
+            if (const auto position = flags.rfind(option); position != string::npos) {
+                const auto start{ position + option.length() };
+
+                return std::make_tuple(start, std::min(flags.find(' ', start), flags.length()));
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    std::optional<string> get_jobserver_auth() {
+        const char* makeflags{ std::getenv("MAKEFLAGS") };
+
+        if (makeflags == nullptr) {
+            return std::nullopt;
+        }
+
+        const string flags{ makeflags };
+        const auto auth{ find_jobserver_auth(flags) };
+
+        if (!auth.has_value()) {
+            return std::nullopt;
+        }
+
+        const auto [start, end] = auth.value();
+
+        return flags.substr(start, end - start);
+    }
+
+    std::optional<std::tuple<int, int>> parse_pipe(const string& auth) {
+        const auto [read_end, write_end] = workspace::util::get_key_value_pair_from_line(auth, ",");
+
+        try {
+            return std::make_tuple(std::stoi(read_end), std::stoi(write_end));
+        } catch (const std::exception&) {
+            return std::nullopt;
+        }
+    }
+
+    Role join(const string& auth) {
+        if (auth.starts_with("fifo:")) {
+            const string fifo{ auth.substr(string("fifo:").length()) };
+
+            read_fd = open(fifo.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+            write_fd = open(fifo.c_str(), O_WRONLY | O_CLOEXEC);
+            owned_fds = { read_fd, write_fd };
+
+            return is_open(read_fd) && is_open(write_fd) ? Role::CLIENT : Role::UNAVAILABLE;
+        }
+
+        const std::optional<std::tuple<int, int>> pipe_ends{ parse_pipe(auth) };
+
+        if (!pipe_ends.has_value()) {
+            return Role::UNAVAILABLE;
+        }
+
+        const auto [shared_read_fd, shared_write_fd] = pipe_ends.value();
+
+        if (!is_open(shared_read_fd) || !is_open(shared_write_fd)) {
+            return Role::UNAVAILABLE;
+        }
+
+        write_fd = shared_write_fd;
+        read_fd = open_private_reader(shared_read_fd);
+
+        if (read_fd != shared_read_fd) {
+            owned_fds = { read_fd };
+        }
+
+        return Role::CLIENT;
+    }
+
+    Role serve(const unsigned int slots) {
+        int fds[2];
+
+        if (pipe(fds) != 0) {
+            throw std::runtime_error("Could not create the jobserver pipe");
+        }
+
+        write_fd = fds[1];
+        read_fd = open_private_reader(fds[0]);
+        owned_fds = { fds[0], fds[1] };
+
+        if (read_fd != fds[0]) {
+            owned_fds.push_back(read_fd);
+        }
+
+        for (unsigned int token = 1; token < slots; ++token) {
+            [[maybe_unused]] const auto written = write(write_fd, &TOKEN, 1);
+        }
+
+        const char* makeflags{ std::getenv("MAKEFLAGS") };
+        const string auth{ std::to_string(fds[0]) + "," + std::to_string(fds[1]) };
+
+        workspace::util::set_env("MAKEFLAGS", string(makeflags != nullptr ? makeflags : "") + " -j" + std::to_string(slots) + " --jobserver-auth=" + auth);
+
+        return Role::SERVER;
+    }
+    #endif
+}
+
+namespace workspace::jobserver {
+    Role initialise(const unsigned int slots) {
+        if (role.has_value()) {
+            return role.value();
+        }
+
+        #if defined(_WIN32) || defined(_WIN64)
+        // Jobs run one at a time on Windows
+        (void)slots;
+        role = Role::UNAVAILABLE;
+        #else
+        const std::optional<string> auth{ get_jobserver_auth() };
+
+        role = auth.has_value() ? join(auth.value()) : serve(slots);
+
+        if (role == Role::UNAVAILABLE) {
+            std::cout << "[WARN] Jobserver advertised in 'MAKEFLAGS' is unavailable (prefix the recipe invoking cbt with '+'). Compiling serially." << std::endl;
+        }
+        #endif
+
+        return role.value();
+    }
+
+    bool try_acquire() {
+        #if defined(_WIN32) || defined(_WIN64)
+        return false;
+        #else
+        if (role != Role::CLIENT && role != Role::SERVER) {
+            return false;
+        }
+
+        pollfd readiness{ .fd{ read_fd }, .events{ POLLIN }, .revents{ 0 } };
+
+        if (poll(&readiness, 1, 0) <= 0) {
+            return false;
+        }
+
+        char token{ 0 };
+
+        return read(read_fd, &token, 1) == 1;
+        #endif
+    }
+
+    void release() {
+        #if !defined(_WIN32) && !defined(_WIN64)
+        if (role == Role::CLIENT || role == Role::SERVER) {
+            [[maybe_unused]] const auto written = write(write_fd, &TOKEN, 1);
+        }
+        #endif
+    }
+
+    void wait_for_token(const std::chrono::milliseconds timeout) {
+        #if !defined(_WIN32) && !defined(_WIN64)
+        pollfd readiness{ .fd{ read_fd }, .events{ POLLIN }, .revents{ 0 } };
+
+        poll(&readiness, 1, static_cast<int>(timeout.count()));
+        #else
+        (void)timeout;
+        #endif
+    }
+
+    std::optional<std::tuple<int, int>> find_advertised_pipe() {
+        #if defined(_WIN32) || defined(_WIN64)
+        return std::nullopt;
+        #else
+        const std::optional<string> auth{ get_jobserver_auth() };
+
+        if (!auth.has_value() || auth->starts_with("fifo:")) {
+            return std::nullopt;
+        }
+
+        const std::optional<std::tuple<int, int>> pipe_ends{ parse_pipe(auth.value()) };
+
+        if (!pipe_ends.has_value() || !is_open(std::get<0>(pipe_ends.value())) || !is_open(std::get<1>(pipe_ends.value()))) {
+            return std::nullopt;
+        }
+
+        return pipe_ends;
+        #endif
+    }
+
+    void readvertise_pipe(const int read_end, const int write_end) {
+        #if !defined(_WIN32) && !defined(_WIN64)
+        const char* makeflags{ std::getenv("MAKEFLAGS") };
+
+        if (makeflags == nullptr) {
+            return;
+        }
+
+        string flags{ makeflags };
+        const auto auth{ find_jobserver_auth(flags) };
+
+        // A named pipe is reached by its path rather than by descriptors
+        if (!auth.has_value() || flags.substr(std::get<0>(auth.value())).starts_with("fifo:")) {
+            return;
+        }
+
+        const auto [start, end] = auth.value();
+
+        flags.replace(start, end - start, std::to_string(read_end) + "," + std::to_string(write_end));
+
+        workspace::util::set_env("MAKEFLAGS", flags);
+        #else
+        (void)read_end;
+        (void)write_end;
+        #endif
+    }
+
+    void reset() {
+        #if !defined(_WIN32) && !defined(_WIN64)
+        for (const int fd: owned_fds) {
+            close(fd);
+        }
+        #endif
+
+        owned_fds.clear();
+        read_fd = -1;
+        write_fd = -1;
+        role = std::nullopt;
+    }
+}
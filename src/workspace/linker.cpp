@@ -0,0 +1,164 @@
+#include "workspace/linker.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "gnu_toolchain.hpp"
+
+namespace {
+    using namespace workspace::linker;
+
+    namespace fs = std::filesystem;
+
+    const string TOOLCHAIN_IDENTITY_FILE{ ".internals/tmp/toolchain.txt" };
+
+    // Compiler version and target along with the linkers it can use, so that installing a linker benchmarks again
+    const string& get_toolchain_identity() {
+        static std::optional<string> identity{};
+
+        if (identity.has_value()) {
+            return identity.value();
+        }
+
+        fs::create_directories(fs::path(TOOLCHAIN_IDENTITY_FILE).parent_path());
+
+        string key{};
+
+        if (gnu_toolchain::write_toolchain_identity(TOOLCHAIN_IDENTITY_FILE) == 0) {
+            std::ifstream stream(TOOLCHAIN_IDENTITY_FILE);
+
+            for (string word; stream >> word;) {
+                key += word + " ";
+            }
+        }
+
+        const std::vector<string> linkers{ detect() };
+
+        for (const auto& linker: linkers) {
+            key += linker + (linker == linkers.back() ? "" : ",");
+        }
+
+        identity = key;
+
+        return identity.value();
+    }
+
+    std::map<string, string> read_choices() {
+        std::map<string, string> choices{};
+        std::ifstream stream(LINKER_CHOICES_PATH);
+
+        for (string line; std::getline(stream, line);) {
+            if (const auto separator = line.rfind('='); separator != string::npos) {
+                choices[line.substr(0, separator)] = line.substr(separator + 1);
+            }
+        }
+
+        return choices;
+    }
+
+    void record_choice(const string& linker) {
+        std::map<string, string> choices{ read_choices() };
+        choices[get_toolchain_identity()] = linker;
+
+        fs::create_directories(fs::path(LINKER_CHOICES_PATH).parent_path());
+        std::ofstream stream(LINKER_CHOICES_PATH);
+
+        for (const auto& [toolchain, choice]: choices) {
+            stream << toolchain << "=" << choice << "\n";
+        }
+    }
+}
+
+namespace workspace::linker {
+    bool is_valid(const string& linker) {
+        return linker == "auto" || linker == "default" || std::ranges::find(CANDIDATES, linker) != CANDIDATES.end();
+    }
+
+    std::vector<string> detect() {
+        static std::optional<std::vector<string>> detected{};
+
+        if (!detected.has_value()) {
+            detected = std::vector<string>{};
+
+            for (const auto& linker: CANDIDATES) {
+                if (gnu_toolchain::probe_linker(linker) == 0) {
+                    detected->push_back(linker);
+                }
+            }
+        }
+
+        return detected.value();
+    }
+
+    std::optional<string> get_linker(const workspace::project_config::Project& project) {
+        const string linker{ project.config.linker.value_or("default") };
+
+        if (linker == "default") {
+            return std::nullopt;
+        }
+
+        if (linker != "auto") {
+            return linker;
+        }
+
+        const std::map<string, string> choices{ read_choices() };
+
+        // `default` when no candidate could be used on this toolchain
+        if (const auto choice = choices.find(get_toolchain_identity()); choice != choices.end() && choice->second != "default") {
+            return choice->second;
+        }
+
+        return std::nullopt;
+    }
+
+    bool needs_benchmark(const workspace::project_config::Project& project) {
+        return project.config.linker.value_or("default") == "auto" && !read_choices().contains(get_toolchain_identity());
+    }
+
+    Benchmark benchmark(const workspace::project_config::Project& project, const std::function<int(const workspace::project_config::Project&)>& link) {
+        std::vector<string> candidates{ detect() };
+
+        // Linking with 'bfd' would fall back to 'gold' for the index
+        if (project.config.gdb_index.value_or(false)) {
+            std::erase(candidates, string("bfd"));
+        }
+
+        Benchmark result{ .choice{ candidates.empty() ? "default" : candidates.front() }, .timings{} };
+
+        if (candidates.empty()) {
+            record_choice(result.choice);
+            return result;
+        }
+
+        workspace::project_config::Project candidate_project{ project };
+        std::optional<std::size_t> fastest_link_time{};
+
+        // Warms up the file cache so that the first candidate is not penalised for reading the objects
+        candidate_project.config.linker = candidates.front();
+        link(candidate_project);
+
+        for (const auto& candidate: candidates) {
+            candidate_project.config.linker = candidate;
+
+            const auto start{ std::chrono::steady_clock::now() };
+            const int exit_code{ link(candidate_project) };
+            const auto link_time{ static_cast<std::size_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count()) };
+
+            result.timings.push_back(Timing{ .linker{ candidate }, .link_time{ exit_code == 0 ? std::optional<std::size_t>{ link_time } : std::nullopt } });
+
+            if (exit_code == 0 && (!fastest_link_time.has_value() || link_time < fastest_link_time.value())) {
+                fastest_link_time = link_time;
+                result.choice = candidate;
+            }
+        }
+
+        record_choice(result.choice);
+
+        return result;
+    }
+}
@@ -1,10 +1,13 @@
 #include "workspace/modification_identifier.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <optional>
+#include <queue>
 #include <regex>
 #include <set>
 #include <sstream>
@@ -12,13 +15,20 @@
 #include <tuple>
 #include <vector>
 
+#include "workspace/cpp_modules.hpp"
+#include "workspace/dependency_graph.hpp"
+#include "workspace/file_snapshot.hpp"
 #include "workspace/project_config.hpp"
+#include "workspace/test_runner.hpp"
+#include "workspace/trace.hpp"
 #include "workspace/util.hpp"
 #include "gnu_toolchain.hpp"
 
 namespace {
     using namespace workspace::modification_identifier;
 
+    namespace dependency_graph = workspace::dependency_graph;
+
     namespace cr = std::chrono;
     namespace fs = std::filesystem;
 
@@ -28,6 +38,10 @@ namespace {
 
     const string MAKEFILE_PATH{ ".internals/tmp/makefile" };
     const string TIMESTAMPS_PATH{ ".internals/timestamps.txt" };
+    const string GRAPHS_PATH{ ".internals/graphs" };
+
+    // Databases written before timestamps moved to milliseconds lack this marker and are upscaled on read
+    const string MILLISECONDS_MARKER{ "; resolution=ms" };
     
     std::tuple<FileHash, fs::path> compute_hash_and_file_pair(const string& file_name) {
         const string normalised_file_name = workspace::util::get_platform_formatted_filename(file_name);
@@ -37,10 +51,10 @@ namespace {
     }
 
     std::size_t get_last_modified_timestamp(const fs::path& path) {
-        return static_cast<std::size_t>(cr::duration_cast<cr::seconds>(fs::last_write_time(path).time_since_epoch()).count());
+        return workspace::file_snapshot::get_last_modified_timestamp(path);
     }
 
-    std::tuple<FileHash, SourceFile> parse_line(const string& line) {
+    std::tuple<FileHash, SourceFile> parse_line(const string& line, const std::size_t timestamp_scale) {
         std::stringstream stream(line);
 
         FileHash hash;
@@ -68,14 +82,28 @@ namespace {
 
         stream.ignore(1);
 
+        // Absent from databases written before peak memory was recorded
+        std::size_t peak_memory{ 0 };
+
+        if (!(stream >> peak_memory)) {
+            peak_memory = 0;
+        }
+
+        // A legacy timestamp stands for any instant within its second, so the end of that second is taken for
+        // those compared against modification times, lest every file look modified after an upgrade
+        const auto upscale_to_end_of_unit = [&timestamp_scale](const std::size_t timestamp) {
+            return timestamp * timestamp_scale + (timestamp_scale - 1);
+        };
+
         return std::make_tuple(hash, SourceFile{
             .hash{ hash },
             .file_name{},
-            .last_modified_timestamp{ last_modified_timestamp },
-            .compilation_start_timestamp{ compilation_start_timestamp },
-            .compilation_end_timestamp{ compilation_end_timestamp },
+            .last_modified_timestamp{ upscale_to_end_of_unit(last_modified_timestamp) },
+            .compilation_start_timestamp{ compilation_start_timestamp * timestamp_scale },
+            .compilation_end_timestamp{ upscale_to_end_of_unit(compilation_end_timestamp) },
             .affected { false },
-            .was_successful{ was_successful }
+            .was_successful{ was_successful },
+            .peak_memory{ peak_memory }
         });
     }
 
@@ -87,14 +115,20 @@ namespace {
             std::ifstream timestamps_file(timestamps_file_name);
             string line;
 
+            std::size_t timestamp_scale{ 1000 };
+
             while (std::getline(timestamps_file, line)) {
                 std::erase(line, '\r');
 
+                if (line == MILLISECONDS_MARKER) {
+                    timestamp_scale = 1;
+                }
+
                 if (line.empty() || line.starts_with(";")) {
                     continue;
                 }
 
-                const auto [hash, source_file] = parse_line(line);
+                const auto [hash, source_file] = parse_line(line, timestamp_scale);
                 files_with_timestamps[hash] = source_file;
             }
         } else {
@@ -112,50 +146,98 @@ namespace {
         #endif
     }
 
+    // Watch mode keeps every graph scanned along with the files changed since, so only those get rescanned
+    struct ResidentGraph {
+        dependency_graph::Graph graph;
+        std::set<string> pending_changes;
+    };
+
+    bool keeps_graphs_resident{ false };
+    std::map<string, ResidentGraph> resident_graphs{};
+
+    void scan_dependencies(const workspace::project_config::Project& project, const string& files, const bool compile_as_dependency) {
+        if (fs::exists(MAKEFILE_PATH)) {
+            fs::remove(MAKEFILE_PATH);
+        }
+
+        // 'g++' only takes module interfaces for C++ when told so, which applies to every file after '-x c++'
+        std::istringstream tokens{ files };
+        string arguments{};
+        string module_interfaces{};
+
+        for (string token; tokens >> token; ) {
+            (token.ends_with(workspace::cpp_modules::MODULE_INTERFACE_EXTENSION) ? module_interfaces : arguments) += token + " ";
+        }
+
+        const int result = gnu_toolchain::generate_makefile(project, arguments + (module_interfaces.empty() ? "" : "-x c++ " + module_interfaces), compile_as_dependency);
+
+        if (result != 0) {
+            throw std::runtime_error("Could not compile project!");
+        }
+    }
+
     void generate_makefile(const workspace::project_config::Project& project, const string& path, const bool compile_as_dependency = false) {
-        string files{ path + "/*.cpp " };
+        const workspace::trace::Span span{ "generate_makefile", { { "path", path } } };
+
+        const bool has_top_level_files = std::ranges::any_of(
+            workspace::file_snapshot::list_directory(path),
+            [](const string& entry){ return entry.ends_with(".cpp") && !workspace::file_snapshot::is_directory(entry); }
+        );
+
+        const bool has_top_level_module_interfaces = std::ranges::any_of(
+            workspace::file_snapshot::list_directory(path),
+            [](const string& entry){ return workspace::cpp_modules::is_module_interface(entry) && !workspace::file_snapshot::is_directory(entry); }
+        );
+
+        string files{ has_top_level_files ? path + "/*.cpp " : "" };
         const string SEPARATOR{ fs::path::preferred_separator };
 
-        for (auto dir_entry = fs::recursive_directory_iterator(path); dir_entry != fs::recursive_directory_iterator(); ++dir_entry) {
-            const string normalised_path{ workspace::util::get_platform_formatted_filename(dir_entry->path().string()) };
+        if (has_top_level_module_interfaces) {
+            files += path + "/*" + workspace::cpp_modules::MODULE_INTERFACE_EXTENSION + " ";
+        }
 
-            if (fs::is_directory(*dir_entry)) {
+        for (const auto& entry: workspace::file_snapshot::list_directory_recursively(path)) {
+            if (workspace::file_snapshot::is_directory(entry)) {
+                const string normalised_path{ workspace::util::get_platform_formatted_filename(entry) };
                 const string file_extension{ is_c_directory(normalised_path) ? ".c" : ".cpp" };
 
-                const int files_count = std::count_if(
-                    fs::directory_iterator(dir_entry->path()),
-                    {}, 
-                    [&file_extension](auto& entry){ return entry.is_regular_file() && entry.path().string().ends_with(file_extension); }
+                const int files_count = std::ranges::count_if(
+                    workspace::file_snapshot::list_directory(entry),
+                    [&file_extension](const string& file){ return file.ends_with(file_extension) && !workspace::file_snapshot::is_directory(file); }
                 );
 
                 if (files_count != 0) {
                     files += normalised_path + SEPARATOR + "*" + file_extension + " ";
                 }
-            }
-        }
 
-        if (fs::exists(MAKEFILE_PATH)) {
-            fs::remove(MAKEFILE_PATH);
-        }
-
-        const int result = gnu_toolchain::generate_makefile(project, files, compile_as_dependency);
+                const bool has_module_interfaces = !is_c_directory(normalised_path) && std::ranges::any_of(
+                    workspace::file_snapshot::list_directory(entry),
+                    [](const string& file){ return workspace::cpp_modules::is_module_interface(file) && !workspace::file_snapshot::is_directory(file); }
+                );
 
-        if (result != 0) {
-            throw std::runtime_error("Could not compile project!");
+                if (has_module_interfaces) {
+                    files += normalised_path + SEPARATOR + "*" + workspace::cpp_modules::MODULE_INTERFACE_EXTENSION + " ";
+                }
+            }
         }
+
+        scan_dependencies(project, files, compile_as_dependency);
     }
 
-    RawDependencyTree parse_makefile() {
+    dependency_graph::Graph parse_makefile() {
+        const workspace::trace::Span span{ "parse_makefile" };
+
         const string makefile_name{ MAKEFILE_PATH };
 
         if (fs::exists(makefile_name)) {
             std::ifstream makefile(makefile_name);
             string line;
 
-            RawDependencyTree cpp_pov;
+            dependency_graph::Builder builder{};
 
             bool keep_continuing{ false };
-            string current_file{""};
+            bool within_rule{ false };
+            dependency_graph::NodeId current_file{ 0 };
             const string DELIMITER{ ": " };
 
             #if defined(_WIN32) || defined(_WIN64)
@@ -188,14 +270,14 @@ namespace {
                 for (std::sregex_iterator match = words; match != std::sregex_iterator(); ++match) {
                     const string file = match->str();
 
-                    if (current_file.empty()) {
+                    if (!within_rule) {
+                        within_rule = true;
+
                         #if defined(_WIN32) || defined(_WIN64)
-                        current_file = std::regex_replace(file, std::regex("\\\\"), "/");
+                        current_file = dependency_graph::add_translation_unit(builder, std::regex_replace(file, std::regex("\\\\"), "/"));
                         #else
-                        current_file = file;
+                        current_file = dependency_graph::add_translation_unit(builder, file);
                         #endif
-
-                        cpp_pov[current_file] = {};
                     } else {
                         if (!file.ends_with(".c") && !file.ends_with(".cpp") && !file.starts_with("tests")) {
                             #if defined(_WIN32) || defined(_WIN64)
@@ -204,26 +286,32 @@ namespace {
                             }
                             #endif
 
-                            cpp_pov[current_file].push_back(file);
+                            dependency_graph::add_include(builder, current_file, file);
                         }
                     }
                 }
 
                 if (!keep_continuing) {
-                    current_file.clear();
+                    within_rule = false;
                 }
             }
 
-            for (const auto& [file, dependencies]: cpp_pov) {
+            dependency_graph::Graph graph{ dependency_graph::build(std::move(builder)) };
+
+            for (const dependency_graph::NodeId node: graph.translation_units) {
+                const string& file{ dependency_graph::get_path(graph, node) };
+
                 if ((file.starts_with("src/c/")) && !file.ends_with(".c")) {
                     throw std::runtime_error("'src/c/' directory can only host C implementation files having '.c' extension (while resolving '" + file + "')");
-                } else if (!file.starts_with("src/c/") && !file.ends_with(".cpp")) {
-                    throw std::runtime_error("C++ implementation files must have '.cpp' extension (while resolving '" + file + "')");
+                } else if (!file.starts_with("src/c/") && !file.ends_with(".cpp") && !(file.starts_with("src/") && workspace::cpp_modules::is_module_interface(file))) {
+                    throw std::runtime_error("C++ implementation files must have '.cpp' extension, or '" + workspace::cpp_modules::MODULE_INTERFACE_EXTENSION + "' for module interfaces under 'src/' (while resolving '" + file + "')");
                 } else if (file.starts_with("tests/unit_tests/") && !file.ends_with(".cpp")) {
                     throw std::runtime_error("Test files must be C++ files and have '.cpp' extension (while resolving '" + file + "')");
                 }
 
-                for (const string& dependency: dependencies) {
+                for (const dependency_graph::NodeId dependency_node: dependency_graph::get_neighbours(graph.includes, node)) {
+                    const string& dependency{ dependency_graph::get_path(graph, dependency_node) };
+
                     if (file.starts_with("src/c/") && !dependency.ends_with(".h")) {
                         throw std::runtime_error("C implementation files can only include C header files having '.h' extension (while including '" + dependency + "' for '" + file + "')");
                     } else if (dependency.starts_with("headers/c/") && !dependency.ends_with(".h")) {
@@ -234,26 +322,25 @@ namespace {
                 }
             }
 
-            return cpp_pov;
+            return graph;
         } else {
             throw std::runtime_error("Makefile '.internals/tmp/makefile' missing!");
         }
     }
 
-    RawDependencyTree convert_to_hpp_pov(const RawDependencyTree& cpp_pov) {
-        RawDependencyTree hpp_pov;
+    // Test and benchmark trees are small and consumed by path, so they are handed out in their string form
+    RawDependencyTree convert_to_cpp_pov(const dependency_graph::Graph& graph) {
+        RawDependencyTree cpp_pov;
 
-        for (auto const& [file, dependencies]: cpp_pov) {
-            for (auto const& dependency: dependencies) {
-                if (!hpp_pov.contains(dependency)) {
-                    hpp_pov[dependency] = { file };
-                } else {
-                    hpp_pov[dependency].push_back(file);
-                }
+        for (const dependency_graph::NodeId node: graph.translation_units) {
+            std::vector<string>& dependencies{ cpp_pov[dependency_graph::get_path(graph, node)] };
+
+            for (const dependency_graph::NodeId dependency: dependency_graph::get_neighbours(graph.includes, node)) {
+                dependencies.push_back(dependency_graph::get_path(graph, dependency));
             }
         }
 
-        return hpp_pov;
+        return cpp_pov;
     }
    
     SourceFile get_or_construct_source_file(const string& file_name, DB& timestamps_history) {
@@ -267,7 +354,7 @@ namespace {
             source_file.file_name = workspace::util::get_platform_formatted_filename(file_path);
             
             if ((file_last_modified_timestamp > source_file.last_modified_timestamp)
-                || ((source_file.file_name.ends_with(".c") || source_file.file_name.ends_with(".cpp"))
+                || ((source_file.file_name.ends_with(".c") || source_file.file_name.ends_with(".cpp") || workspace::cpp_modules::is_module_interface(source_file.file_name))
                     && (!source_file.was_successful || file_last_modified_timestamp > source_file.compilation_end_timestamp))
             ) {
                 source_file.affected = true;
@@ -284,52 +371,168 @@ namespace {
                 .compilation_start_timestamp{ static_cast<std::size_t>(0) },
                 .compilation_end_timestamp{ static_cast<std::size_t>(0) },
                 .affected { true },
-                .was_successful{ false }
+                .was_successful{ false },
+                .peak_memory{ static_cast<std::size_t>(0) }
             };
         }
     }
 
+    // Indexed by `NodeId`: every file is looked up once, then modified headers mark their dependants
     SourceFiles construct_annotated_list_of_source_files(
-        RawDependencyTree& hpp_pov,
+        const dependency_graph::Graph& graph,
         DB& timestamps_history
     ) {
+        const workspace::trace::Span span{ "construct_annotated_list_of_source_files" };
+
         SourceFiles bucket{};
-        
-        for (auto& [header_file, dependants]: hpp_pov) {
-            SourceFile hpp_file{ get_or_construct_source_file(header_file, timestamps_history) };
-            bucket.insert(hpp_file);
+        bucket.reserve(dependency_graph::size(graph));
 
-            for (const auto& dependant: dependants) {
-                SourceFile cpp_file{ get_or_construct_source_file(dependant, timestamps_history) };
+        dependency_graph::NodeSet dirty(dependency_graph::size(graph), false);
 
-                if (hpp_file.affected) {
-                    cpp_file.affected = true;
-                }
+        for (dependency_graph::NodeId node = 0; node < dependency_graph::size(graph); ++node) {
+            bucket.push_back(get_or_construct_source_file(dependency_graph::get_path(graph, node), timestamps_history));
+            dirty[node] = bucket.back().affected;
+        }
 
-                if (!bucket.contains(cpp_file)) {
-                    bucket.insert(cpp_file);
-                } else {
-                    if (auto existing_file = bucket.find(cpp_file); existing_file != bucket.end()) {
-                        if (!existing_file->affected && hpp_file.affected) {
-                            existing_file->affected = true;
-                        }
-                    }
-                }
-            }
+        const dependency_graph::NodeSet affected{ dependency_graph::propagate_dirty(graph, std::move(dirty)) };
+
+        for (dependency_graph::NodeId node = 0; node < dependency_graph::size(graph); ++node) {
+            bucket[node].affected = affected[node];
         }
 
         return bucket;
     }
     
-    RawDependencyTree get_source_files_with_dependants(const workspace::project_config::Project& project, const string& path, const bool compile_as_dependency = false) {
-        generate_makefile(project, path, compile_as_dependency);
+    fs::path get_dependency_graph_file(const string& path) {
+        string graph_name{ path };
+        std::replace(graph_name.begin(), graph_name.end(), '/', '_');
+
+        return fs::path(GRAPHS_PATH) / (graph_name + ".txt");
+    }
+
+    void persist_dependency_graph(const string& path, const dependency_graph::Graph& graph) {
+        const fs::path graph_file{ get_dependency_graph_file(path) };
+
+        fs::create_directories(graph_file.parent_path());
+
+        std::ofstream file_to_write(graph_file);
+
+        file_to_write << "; CBT generated. DO NOT EDIT!\n";
+
+        for (const dependency_graph::NodeId node: graph.translation_units) {
+            file_to_write << dependency_graph::get_path(graph, node) << "|";
+
+            const auto dependencies{ dependency_graph::get_neighbours(graph.includes, node) };
+
+            for (std::size_t i = 0; i < dependencies.size(); ++i) {
+                file_to_write << (i == 0 ? "" : ",") << dependency_graph::get_path(graph, dependencies[i]);
+            }
+
+            file_to_write << "\n";
+        }
+
+        file_to_write.close();
+    }
+
+    // The files `generate_makefile` hands to `g++ -MM` for `path`
+    bool is_translation_unit_of(const string& path, const string& file) {
+        return file.starts_with(path + "/") && (file.starts_with("src/c/") ? file.ends_with(".c") : (file.ends_with(".cpp") || workspace::cpp_modules::is_module_interface(file)));
+    }
+
+    // Keeps the translation units of `resident` that are neither in `rescanned` nor removed, along with all of
+    // those in `rescanned`
+    dependency_graph::Graph merge_graphs(const dependency_graph::Graph& resident, const dependency_graph::Graph& rescanned, const std::set<string>& removed_files) {
+        dependency_graph::Builder builder{};
+
+        const auto copy_translation_unit = [&builder](const dependency_graph::Graph& graph, const dependency_graph::NodeId node) {
+            const dependency_graph::NodeId file{ dependency_graph::add_translation_unit(builder, dependency_graph::get_path(graph, node)) };
+
+            for (const dependency_graph::NodeId dependency: dependency_graph::get_neighbours(graph.includes, node)) {
+                dependency_graph::add_include(builder, file, dependency_graph::get_path(graph, dependency));
+            }
+        };
+
+        for (const dependency_graph::NodeId node: resident.translation_units) {
+            const string& file{ dependency_graph::get_path(resident, node) };
+
+            if (!removed_files.contains(file) && !dependency_graph::find(rescanned.table, file).has_value()) {
+                copy_translation_unit(resident, node);
+            }
+        }
+
+        for (const dependency_graph::NodeId node: rescanned.translation_units) {
+            copy_translation_unit(rescanned, node);
+        }
+
+        return dependency_graph::build(std::move(builder));
+    }
 
-        RawDependencyTree cpp_pov = parse_makefile();
+    // A modified file may include something else now, and so may everything including it, while new
+    // translation units are scanned for the first time
+    dependency_graph::Graph rescan_changed_files(const workspace::project_config::Project& project, const string& path, const ResidentGraph& resident, const bool compile_as_dependency) {
+        const workspace::trace::Span span{ "rescan_changed_files", { { "path", path } } };
+
+        const dependency_graph::Graph& graph{ resident.graph };
+
+        std::set<string> files_to_rescan{};
+        std::set<string> removed_files{};
+
+        for (const dependency_graph::NodeId node: graph.translation_units) {
+            if (!workspace::file_snapshot::exists(dependency_graph::get_path(graph, node))) {
+                removed_files.insert(dependency_graph::get_path(graph, node));
+            }
+        }
+
+        for (const auto& change: resident.pending_changes) {
+            if (is_translation_unit_of(path, change)) {
+                files_to_rescan.insert(change);
+            }
+
+            if (const auto node{ dependency_graph::find(graph.table, change) }; node.has_value()) {
+                for (const dependency_graph::NodeId dependant: dependency_graph::get_neighbours(graph.dependants, node.value())) {
+                    files_to_rescan.insert(dependency_graph::get_path(graph, dependant));
+                }
+            }
+        }
+
+        std::erase_if(files_to_rescan, [](const string& file) { return !workspace::file_snapshot::exists(file); });
+
+        if (files_to_rescan.empty()) {
+            return removed_files.empty() ? graph : merge_graphs(graph, dependency_graph::Graph{}, removed_files);
+        }
+
+        string files{};
+
+        for (const auto& file: files_to_rescan) {
+            files += file + " ";
+        }
+
+        scan_dependencies(project, files, compile_as_dependency);
+
+        return merge_graphs(graph, parse_makefile(), removed_files);
+    }
+
+    dependency_graph::Graph get_source_files_with_dependants(const workspace::project_config::Project& project, const string& path, const bool compile_as_dependency = false) {
+        const string resident_key{ (fs::current_path() / path).generic_string() };
+        const auto resident{ keeps_graphs_resident ? resident_graphs.find(resident_key) : resident_graphs.end() };
+
+        dependency_graph::Graph graph{};
+
+        if (resident != resident_graphs.end()) {
+            graph = rescan_changed_files(project, path, resident->second, compile_as_dependency);
+        } else {
+            generate_makefile(project, path, compile_as_dependency);
+            graph = parse_makefile();
+        }
 
         std::set<string> unresolved_dependencies;
 
-        for (const auto& [file, dependencies]: cpp_pov) {
-            for (const string& dependency: dependencies) {
+        for (const dependency_graph::NodeId node: graph.translation_units) {
+            const string& file{ dependency_graph::get_path(graph, node) };
+
+            for (const dependency_graph::NodeId dependency_node: dependency_graph::get_neighbours(graph.includes, node)) {
+                const string& dependency{ dependency_graph::get_path(graph, dependency_node) };
+
                 if (dependency.starts_with("dependencies/")) {
                     const size_t start_index { dependency.find_first_of("/") };
                     const size_t stop_index { dependency.find_first_of("/", start_index + 1) };
@@ -351,29 +554,108 @@ namespace {
             throw std::runtime_error("Unresolved dependencies found! Either add them to 'project.cfg' or remove them from inclusion in respective files."); 
         }
 
-        return cpp_pov;
+        persist_dependency_graph(path, graph);
+
+        if (keeps_graphs_resident) {
+            resident_graphs.insert_or_assign(resident_key, ResidentGraph{ .graph{ graph }, .pending_changes{} });
+        }
+
+        return graph;
+    }
+
+    std::vector<string> list_quoted_includes(const string& file) {
+        static const std::regex include_pattern(R"re(^\s*#\s*include\s*"([^"]+)")re");
+
+        std::ifstream source(file);
+        string line;
+
+        std::vector<string> includes{};
+
+        while (std::getline(source, line)) {
+            std::smatch match;
+
+            if (std::regex_search(line, match, include_pattern)) {
+                includes.push_back(match[1].str());
+            }
+        }
+
+        return includes;
+    }
+
+    // `g++ -MM` only lists the transitive closure, so the chain is rebuilt by following `#include "..."` lines
+    // of the files within that closure, resolved the way `-iquote` does (relative first, then 'headers/')
+    std::vector<string> find_include_chain(const string& file, const string& target, const std::vector<string>& dependencies) {
+        const std::set<string> closure(dependencies.begin(), dependencies.end());
+
+        std::map<string, string> reached_from{ { file, "" } };
+        std::queue<string> to_visit{};
+        to_visit.push(file);
+
+        while (!to_visit.empty() && !reached_from.contains(target)) {
+            const string current{ to_visit.front() };
+            to_visit.pop();
+
+            for (const auto& include: list_quoted_includes(current)) {
+                const std::vector<string> candidates{
+                    (fs::path(current).parent_path() / include).lexically_normal().generic_string(),
+                    (fs::path("headers") / include).generic_string(),
+                    (fs::path(".internals/dh_symlinks") / include).generic_string()
+                };
+
+                for (const auto& candidate: candidates) {
+                    if (closure.contains(candidate)) {
+                        if (!reached_from.contains(candidate)) {
+                            reached_from[candidate] = current;
+                            to_visit.push(candidate);
+                        }
+
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (!reached_from.contains(target)) {
+            return { file, target };
+        }
+
+        std::vector<string> chain{};
+
+        for (string link{ target }; !link.empty(); link = reached_from[link]) {
+            chain.insert(chain.begin(), link);
+        }
+
+        return chain;
+    }
+
+    // Unit tests are built either to executables or, when the test runner aggregates them, to shared objects
+    fs::path get_test_binary(const workspace::project_config::Project& project, const string& file) {
+        #if defined(_WIN32) || defined(_WIN64)
+        const string EXECUTABLE_EXTENSION{ ".exe" };
+        #else
+        const string EXECUTABLE_EXTENSION{ "" };
+        #endif
+
+        const string extension{ workspace::test_runner::get_mode(project) == workspace::test_runner::Mode::EXECUTABLES ? EXECUTABLE_EXTENSION : ".so" };
+        const fs::path scoped_directory_of_file = fs::path{ file }.parent_path().lexically_relative("tests/unit_tests");
+
+        return fs::path("build/test_binaries/unit_tests" / scoped_directory_of_file / fs::path(file).stem().replace_extension(extension));
     }
 }
 
 namespace workspace::modification_identifier {
     std::size_t get_current_fileclock_timestamp() {
-        return static_cast<std::size_t>(cr::duration_cast<cr::seconds>(cr::file_clock::now().time_since_epoch()).count());
+        return static_cast<std::size_t>(cr::duration_cast<cr::milliseconds>(cr::file_clock::now().time_since_epoch()).count());
     }
 
     RawDependencyTree get_files_to_test(const workspace::project_config::Project& project) {
-        RawDependencyTree cpp_pov = get_source_files_with_dependants(project, "tests/unit_tests");
+        RawDependencyTree cpp_pov = convert_to_cpp_pov(get_source_files_with_dependants(project, "tests/unit_tests"));
         RawDependencyTree tree;
 
-        #if defined(_WIN32) || defined(_WIN64)
-        const string EXTENSION{ ".exe" };
-        #else
-        const string EXTENSION{ "" };
-        #endif
-        
         for (auto const& [file, dependencies]: cpp_pov) {
             const fs::path file_path{ file };
 
-            const fs::path scoped_directory_of_file = fs::relative(fs::path{ file }.parent_path(), "tests/unit_tests");
+            const fs::path scoped_directory_of_file = fs::path{ file }.parent_path().lexically_relative("tests/unit_tests");
             const fs::path corresponding_source_file = fs::path(
                 "src"
                 / scoped_directory_of_file
@@ -381,9 +663,9 @@ namespace workspace::modification_identifier {
                     .filename()
                     .replace_extension(file.starts_with("tests/unit_tests/c/") ? "c" : "cpp")
             );
-            const fs::path corresponding_binary = fs::path("build/test_binaries/unit_tests" / scoped_directory_of_file / fs::path(file).stem().replace_extension(EXTENSION));
+            const fs::path corresponding_binary = get_test_binary(project, file);
 
-            if (!fs::exists(corresponding_binary)
+            if (!workspace::file_snapshot::exists(corresponding_binary)
                 || (get_last_modified_timestamp(file_path) > get_last_modified_timestamp(corresponding_binary))
                 || (get_last_modified_timestamp(corresponding_source_file) > get_last_modified_timestamp(corresponding_binary))
             ) {
@@ -402,18 +684,198 @@ namespace workspace::modification_identifier {
         return tree;
     }
 
+    RawDependencyTree get_benchmarks(const workspace::project_config::Project& project) {
+        return convert_to_cpp_pov(get_source_files_with_dependants(project, "tests/benchmarks"));
+    }
+
+    std::optional<RawDependencyTree> load_dependency_graph(const string& path) {
+        const fs::path graph_file{ get_dependency_graph_file(path) };
+
+        if (!fs::exists(graph_file)) {
+            return std::nullopt;
+        }
+
+        std::ifstream graph(graph_file);
+        string line;
+
+        RawDependencyTree cpp_pov{};
+
+        while (std::getline(graph, line)) {
+            std::erase(line, '\r');
+
+            if (line.empty() || line.starts_with(";")) {
+                continue;
+            }
+
+            const auto [file, dependencies] = workspace::util::get_key_value_pair_from_line(line, "|");
+            std::stringstream stream(dependencies);
+            string dependency;
+
+            cpp_pov[file] = {};
+
+            while (std::getline(stream, dependency, ',')) {
+                cpp_pov[file].push_back(dependency);
+            }
+        }
+
+        return cpp_pov;
+    }
+
+    std::map<string, std::size_t> get_recorded_compilation_durations() {
+        const DB timestamps_history{ read_internal_timestamps_file() };
+
+        std::map<string, std::size_t> durations{};
+
+        for (const auto& [file, _]: load_dependency_graph("src").value_or(RawDependencyTree{})) {
+            const FileHash hash{ std::get<0>(compute_hash_and_file_pair(file)) };
+
+            if (const auto it = timestamps_history.find(hash); it != timestamps_history.end() && it->second.compilation_end_timestamp > it->second.compilation_start_timestamp) {
+                durations[file] = it->second.compilation_end_timestamp - it->second.compilation_start_timestamp;
+            }
+        }
+
+        return durations;
+    }
+
+    void keep_graphs_resident() {
+        keeps_graphs_resident = true;
+    }
+
+    void notify_changes(const std::vector<string>& changed_files) {
+        for (auto& [_, resident]: resident_graphs) {
+            resident.pending_changes.insert(changed_files.begin(), changed_files.end());
+        }
+    }
+
+    void discard_resident_graphs() {
+        resident_graphs.clear();
+    }
+
+    std::optional<std::vector<RebuildReason>> explain_rebuild(const workspace::project_config::Project& project, const string& file) {
+        const bool is_test_file{ file.starts_with("tests/unit_tests/") };
+        const RawDependencyTree graph{ load_dependency_graph(is_test_file ? "tests/unit_tests" : "src").value_or(RawDependencyTree{}) };
+
+        const auto entry{ graph.find(file) };
+
+        if (entry == graph.end()) {
+            return std::nullopt;
+        }
+
+        const auto& [_, dependencies] = *entry;
+        std::vector<RebuildReason> reasons{};
+
+        if (is_test_file) {
+            const fs::path scoped_directory_of_file = fs::path{ file }.parent_path().lexically_relative("tests/unit_tests");
+            const fs::path corresponding_source_file = fs::path(
+                "src"
+                / scoped_directory_of_file
+                / fs::path(file)
+                    .filename()
+                    .replace_extension(file.starts_with("tests/unit_tests/c/") ? "c" : "cpp")
+            );
+            const fs::path corresponding_binary = get_test_binary(project, file);
+
+            if (!workspace::file_snapshot::exists(corresponding_binary)) {
+                return std::vector<RebuildReason>{ { "test binary '" + corresponding_binary.generic_string() + "' does not exist", {} } };
+            }
+
+            const std::size_t binary_timestamp{ get_last_modified_timestamp(corresponding_binary) };
+
+            if (get_last_modified_timestamp(file) > binary_timestamp) {
+                reasons.push_back({ "edited since the test binary was built", {} });
+            }
+
+            if (workspace::file_snapshot::exists(corresponding_source_file) && get_last_modified_timestamp(corresponding_source_file) > binary_timestamp) {
+                reasons.push_back({ "'" + corresponding_source_file.generic_string() + "' is newer than the test binary", {} });
+            }
+
+            for (const auto& dependency: dependencies) {
+                if (workspace::file_snapshot::exists(dependency) && get_last_modified_timestamp(dependency) > binary_timestamp) {
+                    reasons.push_back({ "'" + dependency + "' is newer than the test binary", find_include_chain(file, dependency, dependencies) });
+                }
+            }
+
+            return reasons;
+        }
+
+        DB timestamps_history{ read_internal_timestamps_file() };
+
+        // Mirrors `get_or_construct_source_file`
+        const auto [hash, file_path] = compute_hash_and_file_pair(file);
+
+        if (!timestamps_history.contains(hash)) {
+            return std::vector<RebuildReason>{ { "never compiled before", {} } };
+        }
+
+        const SourceFile& recorded_file{ timestamps_history[hash] };
+        const std::size_t file_last_modified_timestamp{ get_last_modified_timestamp(file_path) };
+
+        if (!recorded_file.was_successful) {
+            reasons.push_back({ "last compilation failed", {} });
+        }
+
+        if (file_last_modified_timestamp > recorded_file.last_modified_timestamp || file_last_modified_timestamp > recorded_file.compilation_end_timestamp) {
+            reasons.push_back({ "edited since last compiled", {} });
+        }
+
+        for (const auto& dependency: dependencies) {
+            const auto [dependency_hash, dependency_path] = compute_hash_and_file_pair(dependency);
+
+            if (!workspace::file_snapshot::exists(dependency_path)) {
+                reasons.push_back({ "'" + dependency + "' no longer exists", find_include_chain(file, dependency, dependencies) });
+            } else if (!timestamps_history.contains(dependency_hash)) {
+                reasons.push_back({ "'" + dependency + "' is newly included", find_include_chain(file, dependency, dependencies) });
+            } else if (get_last_modified_timestamp(dependency_path) > timestamps_history[dependency_hash].last_modified_timestamp) {
+                reasons.push_back({ "'" + dependency + "' was modified", find_include_chain(file, dependency, dependencies) });
+            }
+        }
+
+        return reasons;
+    }
+
+    std::vector<const SourceFile*> prioritise_for_compilation(const SourceFiles& bucket) {
+        std::vector<const SourceFile*> files_to_compile{};
+
+        for (auto const& file: bucket) {
+            if ((file.file_name.ends_with(".c") || file.file_name.ends_with(".cpp") || workspace::cpp_modules::is_module_interface(file.file_name)) && file.affected) {
+                files_to_compile.push_back(&file);
+            }
+        }
+
+        const auto needs_quick_feedback = [](const SourceFile* file) {
+            const bool failed_last_time{ file->compilation_end_timestamp != 0 && !file->was_successful };
+            const bool edited_since_last_compilation{ file->last_modified_timestamp > file->compilation_end_timestamp };
+
+            return failed_last_time || edited_since_last_compilation;
+        };
+
+        const auto get_recorded_duration = [](const SourceFile* file) -> std::size_t {
+            return file->compilation_end_timestamp > file->compilation_start_timestamp
+                ? file->compilation_end_timestamp - file->compilation_start_timestamp
+                : 0;
+        };
+
+        std::stable_sort(files_to_compile.begin(), files_to_compile.end(), [&](const SourceFile* lhs, const SourceFile* rhs) {
+            return std::make_tuple(!needs_quick_feedback(lhs), get_recorded_duration(rhs), lhs->file_name)
+                < std::make_tuple(!needs_quick_feedback(rhs), get_recorded_duration(lhs), rhs->file_name);
+        });
+
+        return files_to_compile;
+    }
+
     SourceFiles list_all_files_annotated(const workspace::project_config::Project& project, const bool compile_as_dependency) {
         DB timestamps_history = read_internal_timestamps_file();
 
-        RawDependencyTree cpp_pov = get_source_files_with_dependants(project, "src", compile_as_dependency);
-        RawDependencyTree hpp_pov = convert_to_hpp_pov(cpp_pov);
+        const dependency_graph::Graph graph = get_source_files_with_dependants(project, "src", compile_as_dependency);
 
-        SourceFiles bucket = construct_annotated_list_of_source_files(hpp_pov, timestamps_history);
+        SourceFiles bucket = construct_annotated_list_of_source_files(graph, timestamps_history);
 
         return bucket;
     }
 
     void persist_annotations(const SourceFiles& bucket) {
+        const workspace::trace::Span span{ "persist_annotations" };
+
         if (fs::exists(TIMESTAMPS_PATH)) {
             fs::remove(TIMESTAMPS_PATH);
         }
@@ -421,13 +883,15 @@ namespace workspace::modification_identifier {
         std::ofstream file_to_write(TIMESTAMPS_PATH);
 
         file_to_write << "; CBT generated. DO NOT EDIT!\n";
+        file_to_write << MILLISECONDS_MARKER << "\n";
 
         for(auto const& source_file: bucket) {
             file_to_write << source_file.hash
                 << "," << source_file.last_modified_timestamp
                 << "," << source_file.compilation_start_timestamp
                 << "," << source_file.compilation_end_timestamp
-                << "," << source_file.was_successful << "\n";
+                << "," << source_file.was_successful
+                << "," << source_file.peak_memory << "\n";
         }
         
         file_to_write.close();
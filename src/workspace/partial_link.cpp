@@ -0,0 +1,120 @@
+#include "workspace/partial_link.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "workspace/file_snapshot.hpp"
+#include "workspace/util.hpp"
+
+namespace {
+    using namespace workspace::partial_link;
+
+    namespace fs = std::filesystem;
+
+    string read_file(const fs::path& path) {
+        std::ifstream stream(path, std::ios::binary);
+        std::ostringstream content;
+        content << stream.rdbuf();
+
+        return content.str();
+    }
+
+    void write_if_changed(const fs::path& file, const string& content) {
+        if (!fs::exists(file) || read_file(file) != content) {
+            fs::create_directories(file.parent_path());
+            std::ofstream(file, std::ios::binary) << content;
+            workspace::file_snapshot::invalidate(file.generic_string());
+        }
+    }
+
+    std::vector<string> list_objects_in(const string& directory) {
+        std::vector<string> objects{};
+
+        for (const auto& entry: workspace::file_snapshot::list_directory(directory)) {
+            if (!workspace::file_snapshot::is_directory(entry) && entry.ends_with(".o")) {
+                objects.push_back(workspace::util::get_platform_formatted_filename(entry));
+            }
+        }
+
+        return objects;
+    }
+
+    // E.g. 'binaries/cbt_tools' for 'build/binaries/cbt_tools/', and 'dependencies/some_lib' for any directory
+    // of that dependency
+    string get_group_name(const string& directory) {
+        const fs::path relative_directory{ fs::path(directory).lexically_relative("build") };
+        auto component{ relative_directory.begin() };
+
+        if (*component == "dependencies" && std::next(component) != relative_directory.end()) {
+            return (*component / *std::next(component)).generic_string();
+        }
+
+        return relative_directory.generic_string();
+    }
+}
+
+namespace workspace::partial_link {
+    std::vector<Group> plan(const std::vector<string>& directories_containing_binaries, const std::set<string>& excluded_objects) {
+        std::map<string, std::vector<string>> members_per_group{};
+
+        for (const auto& directory: directories_containing_binaries) {
+            std::vector<string>& members{ members_per_group[get_group_name(directory)] };
+
+            std::ranges::copy_if(list_objects_in(directory), std::back_inserter(members), [&excluded_objects](const auto& object) { return !excluded_objects.contains(object); });
+        }
+
+        std::vector<Group> groups{};
+
+        for (auto& [name, members]: members_per_group) {
+            if (members.size() < 2) {
+                continue;
+            }
+
+            std::ranges::sort(members);
+
+            string content{};
+
+            for (const auto& member: members) {
+                content += member + "\n";
+            }
+
+            const fs::path manifest{ fs::path(PARTIAL_LINK_PATH) / (name + ".objects") };
+
+            write_if_changed(manifest, content);
+
+            groups.push_back(Group{
+                .object{ (fs::path(PARTIAL_LINK_PATH) / (name + ".o")).generic_string() },
+                .members{ members },
+                .manifest{ manifest.generic_string() }
+            });
+        }
+
+        return groups;
+    }
+
+    std::vector<string> list_ungrouped_objects(const std::vector<string>& directories_containing_binaries, const std::vector<Group>& groups, const std::set<string>& excluded_objects) {
+        std::set<string> objects_left_out{ excluded_objects };
+
+        for (const auto& group: groups) {
+            objects_left_out.insert(group.members.begin(), group.members.end());
+        }
+
+        std::vector<string> objects{};
+
+        for (const auto& directory: directories_containing_binaries) {
+            for (const auto& object: list_objects_in(directory)) {
+                if (!objects_left_out.contains(object)) {
+                    objects.push_back(object);
+                }
+            }
+        }
+
+        return objects;
+    }
+}
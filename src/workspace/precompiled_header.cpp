@@ -0,0 +1,234 @@
+#include "workspace/precompiled_header.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "gnu_toolchain.hpp"
+
+namespace {
+    using namespace workspace::precompiled_header;
+
+    namespace fs = std::filesystem;
+
+    using workspace::modification_identifier::RawDependencyTree;
+
+    const string PRECOMPILED_HEADER_NAME{ "cbt_pch.hpp" };
+
+    // Only the standard library is known to exist on every platform regardless of the include guards around
+    // it, whereas e.g. '<windows.h>' is typically included conditionally
+    const std::set<string> STANDARD_HEADERS{
+        "algorithm", "any", "array", "atomic", "barrier", "bit", "bitset", "cassert", "cctype", "cerrno",
+        "cfloat", "charconv", "chrono", "cinttypes", "climits", "cmath", "compare", "complex", "concepts",
+        "condition_variable", "coroutine", "cstddef", "cstdint", "cstdio", "cstdlib", "cstring", "ctime",
+        "deque", "exception", "execution", "expected", "filesystem", "format", "forward_list", "fstream",
+        "functional", "future", "initializer_list", "iomanip", "ios", "iosfwd", "iostream", "istream",
+        "iterator", "latch", "limits", "list", "locale", "map", "memory", "memory_resource", "mutex", "new",
+        "numbers", "numeric", "optional", "ostream", "print", "queue", "random", "ranges", "ratio", "regex",
+        "scoped_allocator", "semaphore", "set", "shared_mutex", "source_location", "span", "sstream", "stack",
+        "stdexcept", "stop_token", "streambuf", "string", "string_view", "system_error", "thread", "tuple",
+        "type_traits", "typeindex", "typeinfo", "unordered_map", "unordered_set", "utility", "valarray",
+        "variant", "vector", "version"
+    };
+
+    std::set<string> list_standard_includes(const string& file) {
+        static const std::regex include_pattern{ R"re(^\s*#\s*include\s*<([^>]+)>)re" };
+
+        std::ifstream stream(file);
+        std::set<string> includes{};
+
+        for (string line; std::getline(stream, line); ) {
+            if (std::smatch match; std::regex_search(line, match, include_pattern) && STANDARD_HEADERS.contains(match[1].str())) {
+                includes.insert(match[1].str());
+            }
+        }
+
+        return includes;
+    }
+
+    // Returns the headers included by at least `MINIMUM_SHARE` of `translation_units` (and two of them),
+    // most included first
+    std::vector<string> select_frequent(const std::map<string, std::size_t>& counts, const std::size_t translation_units) {
+        std::vector<std::pair<string, std::size_t>> frequent{};
+
+        for (const auto& [header, count]: counts) {
+            if (count >= 2 && static_cast<double>(count) >= MINIMUM_SHARE * static_cast<double>(translation_units)) {
+                frequent.emplace_back(header, count);
+            }
+        }
+
+        std::stable_sort(frequent.begin(), frequent.end(), [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+
+        std::vector<string> headers{};
+        std::ranges::transform(frequent, std::back_inserter(headers), [](const auto& entry) { return entry.first; });
+
+        return headers;
+    }
+
+    string get_flags_key(const workspace::project_config::Project& project, const bool compile_as_dependency, const bool position_independent) {
+        std::ostringstream key;
+        key << std::hex << std::hash<string>{}(gnu_toolchain::get_compilation_command(project, compile_as_dependency, std::nullopt, position_independent));
+
+        return key.str();
+    }
+
+    string generate_content(const Selection& selection) {
+        // Relative to the precompiled header, which lives three levels down from the project root
+        const string PROJECT_ROOT{ "../../../" };
+
+        string content{ "// CBT generated. DO NOT EDIT!\n" };
+
+        for (const auto& header: selection.standard_headers) {
+            content += "#include <" + header + ">\n";
+        }
+
+        for (const auto& header: selection.project_headers) {
+            content += "#include \"" + PROJECT_ROOT + header + "\"\n";
+        }
+
+        return content;
+    }
+
+    string read_file(const fs::path& path) {
+        std::ifstream stream(path, std::ios::binary);
+        std::ostringstream content;
+        content << stream.rdbuf();
+
+        return content.str();
+    }
+
+    // The dependency file written alongside lists every header parsed into the precompiled one
+    bool is_outdated(const fs::path& precompiled_header, const fs::path& dependency_file) {
+        std::error_code error;
+        const fs::file_time_type built_at{ fs::last_write_time(precompiled_header, error) };
+
+        if (error || !fs::exists(dependency_file)) {
+            return true;
+        }
+
+        std::istringstream dependencies{ read_file(dependency_file) };
+        string token;
+
+        // Skips the target
+        dependencies >> token;
+
+        while (dependencies >> token) {
+            if (token == "\\") {
+                continue;
+            }
+
+            const fs::file_time_type last_write_time{ fs::last_write_time(token, error) };
+
+            if (error || last_write_time > built_at) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+}
+
+namespace workspace::precompiled_header {
+    Selection select_headers(const RawDependencyTree& sources) {
+        std::map<string, std::size_t> project_header_counts{};
+        std::map<string, std::size_t> standard_header_counts{};
+        std::size_t translation_units{ 0 };
+
+        for (const auto& [file, dependencies]: sources) {
+            // C files can't use a C++ precompiled header
+            if (!file.ends_with(".cpp")) {
+                continue;
+            }
+
+            ++translation_units;
+
+            std::set<string> standard_headers{ list_standard_includes(file) };
+
+            for (const auto& dependency: dependencies) {
+                ++project_header_counts[dependency];
+                standard_headers.merge(list_standard_includes(dependency));
+            }
+
+            for (const auto& header: standard_headers) {
+                ++standard_header_counts[header];
+            }
+        }
+
+        return Selection{
+            .standard_headers{ select_frequent(standard_header_counts, translation_units) },
+            .project_headers{ select_frequent(project_header_counts, translation_units) }
+        };
+    }
+
+    void mark_dependants_affected(const Selection& selection, const workspace::modification_identifier::SourceFiles& files) {
+        const bool is_header_affected{ std::ranges::any_of(files, [&selection](const auto& file) {
+            return file.affected && std::ranges::find(selection.project_headers, file.file_name) != selection.project_headers.end();
+        }) };
+
+        if (!is_header_affected) {
+            return;
+        }
+
+        for (const auto& file: files) {
+            if (file.file_name.ends_with(".cpp")) {
+                file.affected = true;
+            }
+        }
+    }
+
+    std::optional<PrecompiledHeader> prepare(const workspace::project_config::Project& project, const Selection& selection, const bool compile_as_dependency, const bool position_independent) {
+        const std::size_t header_count{ selection.standard_headers.size() + selection.project_headers.size() };
+
+        if (header_count == 0) {
+            return std::nullopt;
+        }
+
+        const fs::path directory{ fs::path(PRECOMPILED_HEADERS_PATH) / get_flags_key(project, compile_as_dependency, position_independent) };
+        const fs::path header{ directory / PRECOMPILED_HEADER_NAME };
+        const fs::path precompiled_header{ directory / (PRECOMPILED_HEADER_NAME + ".gch") };
+        const fs::path dependency_file{ directory / (PRECOMPILED_HEADER_NAME + ".d") };
+
+        const string content{ generate_content(selection) };
+
+        PrecompiledHeader result{
+            .header{ header.generic_string() },
+            .header_count{ header_count },
+            .was_rebuilt{ false },
+            .was_successful{ true },
+            .build_time{ 0 }
+        };
+
+        if (fs::exists(header) && read_file(header) == content && !is_outdated(precompiled_header, dependency_file)) {
+            return result;
+        }
+
+        fs::create_directories(directory);
+
+        // Left as is when only a contained header changed, so the selection itself is not reported as new
+        if (!fs::exists(header) || read_file(header) != content) {
+            std::ofstream(header, std::ios::binary) << content;
+        }
+
+        const auto start{ std::chrono::steady_clock::now() };
+
+        result.was_rebuilt = true;
+        result.was_successful = gnu_toolchain::precompile_header(project, result.header, precompiled_header.generic_string(), dependency_file.generic_string(), compile_as_dependency, position_independent) == 0;
+        result.build_time = static_cast<std::size_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+
+        if (!result.was_successful) {
+            // Otherwise a stale one would be picked up by the next compilation
+            fs::remove(precompiled_header);
+        }
+
+        return result;
+    }
+}
@@ -1,5 +1,7 @@
 #include "workspace/project_config.hpp"
 
+#include <algorithm>
+#include <cctype>
 #include <filesystem>
 #include <fstream>
 #include <numeric>
@@ -7,7 +9,9 @@
 #include <set>
 #include <string>
 
+#include "workspace/linker.hpp"
 #include "workspace/scaffold.hpp"
+#include "workspace/trace.hpp"
 #include "workspace/util.hpp"
 
 namespace {
@@ -25,6 +29,17 @@ namespace {
         "config{compile_time_flags}",
         "config{build_flags}",
         "config{test_flags}",
+        "config{max_memory}",
+        "config{precompiled_header}",
+        "config{unity}",
+        "config{unity_batch_size}",
+        "config{unit_test_runner}",
+        "config{shared_test_libraries}",
+        "config{split_dwarf}",
+        "config{gdb_index}",
+        "config{linker}",
+        "config{partial_link}",
+        "config{prune_unreachable}",
         "cppcheck{bug_hunting}",
         "cppcheck{error_exit_code}",
         "cppcheck{inconclusive}",
@@ -102,7 +117,18 @@ namespace workspace::project_config {
                 .safety_flags{ "-Wall -Wextra -pedantic" },
                 .compile_time_flags{ "-Os -s" },
                 .build_flags{ "-O3 -s" },
-                .test_flags{ "-g -Og" }
+                .test_flags{ "-g -Og" },
+                .max_memory{ std::nullopt },
+                .precompiled_header{ std::nullopt },
+                .unity{ std::nullopt },
+                .unity_batch_size{ std::nullopt },
+                .unit_test_runner{ std::nullopt },
+                .shared_test_libraries{ std::nullopt },
+                .split_dwarf{ std::nullopt },
+                .gdb_index{ std::nullopt },
+                .linker{ std::nullopt },
+                .partial_link{ std::nullopt },
+                .prune_unreachable{ std::nullopt }
             },
             .cppcheck {
                 .bug_hunting{ false },
@@ -183,6 +209,8 @@ namespace workspace::project_config {
     }
 
     Project convert_cfg_to_model() {
+        const workspace::trace::Span span{ "convert_cfg_to_model", { { "directory", fs::current_path().string() } } };
+
         const string config_file_name{ "project.cfg" };
 
         if (fs::exists(config_file_name)) {
@@ -260,6 +288,72 @@ namespace workspace::project_config {
                     project.config.build_flags = value;
                 } else if (key.compare("config{test_flags}") == 0) {
                     project.config.test_flags = value;
+                } else if (key.compare("config{max_memory}") == 0) {
+                    if (!workspace::util::parse_memory_size(value).has_value()) {
+                        throw std::runtime_error("Expected a size such as 512M or 8G for attribute '" + key + "' " + ERROR_LOCATION);
+                    }
+
+                    project.config.max_memory = value;
+                } else if (key.compare("config{precompiled_header}") == 0) {
+                    if (value != "true" && value != "false") {
+                        throw std::runtime_error("Expected either true or false for attribute '" + key + "' " + ERROR_LOCATION);
+                    }
+
+                    project.config.precompiled_header = value == "true" ? true : false;
+                } else if (key.compare("config{unity}") == 0) {
+                    if (value != "on" && value != "off") {
+                        throw std::runtime_error("Expected either on or off for attribute '" + key + "' " + ERROR_LOCATION);
+                    }
+
+                    project.config.unity = value == "on" ? true : false;
+                } else if (key.compare("config{unity_batch_size}") == 0) {
+                    if (value.empty() || value.length() > 6 || !std::ranges::all_of(value, ::isdigit) || std::stoul(value) < 2) {
+                        throw std::runtime_error("Expected a number of files of at least 2 for attribute '" + key + "' " + ERROR_LOCATION);
+                    }
+
+                    project.config.unity_batch_size = std::stoul(value);
+                } else if (key.compare("config{unit_test_runner}") == 0) {
+                    if (value != "executables" && value != "aggregated" && value != "isolated") {
+                        throw std::runtime_error("Expected one of executables, aggregated or isolated for attribute '" + key + "' " + ERROR_LOCATION);
+                    }
+
+                    project.config.unit_test_runner = value;
+                } else if (key.compare("config{shared_test_libraries}") == 0) {
+                    if (value != "on" && value != "off") {
+                        throw std::runtime_error("Expected either on or off for attribute '" + key + "' " + ERROR_LOCATION);
+                    }
+
+                    project.config.shared_test_libraries = value == "on" ? true : false;
+                } else if (key.compare("config{split_dwarf}") == 0) {
+                    if (value != "on" && value != "off") {
+                        throw std::runtime_error("Expected either on or off for attribute '" + key + "' " + ERROR_LOCATION);
+                    }
+
+                    project.config.split_dwarf = value == "on" ? true : false;
+                } else if (key.compare("config{gdb_index}") == 0) {
+                    if (value != "on" && value != "off") {
+                        throw std::runtime_error("Expected either on or off for attribute '" + key + "' " + ERROR_LOCATION);
+                    }
+
+                    project.config.gdb_index = value == "on" ? true : false;
+                } else if (key.compare("config{linker}") == 0) {
+                    if (!workspace::linker::is_valid(value)) {
+                        throw std::runtime_error("Expected one of auto, default, bfd, gold, lld or mold for attribute '" + key + "' " + ERROR_LOCATION);
+                    }
+
+                    project.config.linker = value;
+                } else if (key.compare("config{partial_link}") == 0) {
+                    if (value != "on" && value != "off") {
+                        throw std::runtime_error("Expected either on or off for attribute '" + key + "' " + ERROR_LOCATION);
+                    }
+
+                    project.config.partial_link = value == "on" ? true : false;
+                } else if (key.compare("config{prune_unreachable}") == 0) {
+                    if (value != "on" && value != "off") {
+                        throw std::runtime_error("Expected either on or off for attribute '" + key + "' " + ERROR_LOCATION);
+                    }
+
+                    project.config.prune_unreachable = value == "on" ? true : false;
                 } else if (key == "cppcheck{bug_hunting}") {
                     if (value != "true" && value != "false") {
                         throw std::runtime_error("Expected either true or false for attribute '" + key + "' " + ERROR_LOCATION);
@@ -356,7 +450,18 @@ namespace workspace::project_config {
             + "\nconfig{safety_flags}=" + project.config.safety_flags
             + "\nconfig{compile_time_flags}=" + project.config.compile_time_flags
             + "\nconfig{build_flags}=" + project.config.build_flags
-            + "\nconfig{test_flags}=" + project.config.test_flags };
+            + "\nconfig{test_flags}=" + project.config.test_flags
+            + "\n" + (!project.config.max_memory.has_value() ? "; " : "") + "config{max_memory}=" + project.config.max_memory.value_or("8G") + " ; optional field, defaults to 75% of available memory"
+            + "\n" + (!project.config.precompiled_header.has_value() ? "; " : "") + "config{precompiled_header}=" + (project.config.precompiled_header.value_or(true) ? "true" : "false") + " ; optional boolean field, defaults to false"
+            + "\n" + (!project.config.unity.has_value() ? "; " : "") + "config{unity}=" + (project.config.unity.value_or(true) ? "on" : "off") + " ; optional field, either on or off (default)"
+            + "\n" + (!project.config.unity_batch_size.has_value() ? "; " : "") + "config{unity_batch_size}=" + std::to_string(project.config.unity_batch_size.value_or(8)) + " ; optional field, files per unity batch, defaults to 8"
+            + "\n" + (!project.config.unit_test_runner.has_value() ? "; " : "") + "config{unit_test_runner}=" + project.config.unit_test_runner.value_or("aggregated") + " ; optional field, one of executables (default), aggregated or isolated"
+            + "\n" + (!project.config.shared_test_libraries.has_value() ? "; " : "") + "config{shared_test_libraries}=" + (project.config.shared_test_libraries.value_or(true) ? "on" : "off") + " ; optional field, either on or off (default)"
+            + "\n" + (!project.config.split_dwarf.has_value() ? "; " : "") + "config{split_dwarf}=" + (project.config.split_dwarf.value_or(true) ? "on" : "off") + " ; optional field, either on or off (default), applies to flags with -g"
+            + "\n" + (!project.config.gdb_index.has_value() ? "; " : "") + "config{gdb_index}=" + (project.config.gdb_index.value_or(true) ? "on" : "off") + " ; optional field, either on or off (default), links with gold unless config{linker} is lld or mold"
+            + "\n" + (!project.config.linker.has_value() ? "; " : "") + "config{linker}=" + project.config.linker.value_or("auto") + " ; optional field, one of auto, default (default), bfd, gold, lld or mold"
+            + "\n" + (!project.config.partial_link.has_value() ? "; " : "") + "config{partial_link}=" + (project.config.partial_link.value_or(true) ? "on" : "off") + " ; optional field, either on or off (default)"
+            + "\n" + (!project.config.prune_unreachable.has_value() ? "; " : "") + "config{prune_unreachable}=" + (project.config.prune_unreachable.value_or(true) ? "on" : "off") + " ; optional field, either on or off (default), for applications only" };
         
         const string cppcheck_text{ std::string("; invokes `cppcheck` with following arguments when `cbt perform-static-anaysis` is run")
             + "\n" + (!project.cppcheck.bug_hunting.has_value() ? "; " : "") + "cppcheck{bug_hunting}=" + (project.cppcheck.bug_hunting.value() ? "true" : "false") + " ; optional boolean field"
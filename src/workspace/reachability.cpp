@@ -0,0 +1,56 @@
+#include "workspace/reachability.hpp"
+
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+    using namespace workspace::reachability;
+
+    const string HEADERS_PREFIX{ "headers/" };
+    const string SRC_PREFIX{ "src/" };
+}
+
+namespace workspace::reachability {
+    std::optional<string> get_paired_source(const string& header) {
+        if (!header.starts_with(HEADERS_PREFIX)) {
+            return std::nullopt;
+        }
+
+        const string stem{ header.substr(HEADERS_PREFIX.length(), header.rfind('.') - HEADERS_PREFIX.length()) };
+
+        if (header.ends_with(".hpp")) {
+            return SRC_PREFIX + stem + ".cpp";
+        } else if (header.ends_with(".h")) {
+            return SRC_PREFIX + stem + ".c";
+        }
+
+        return std::nullopt;
+    }
+
+    std::optional<std::set<string>> find_reachable_sources(const workspace::modification_identifier::RawDependencyTree& graph) {
+        if (!graph.contains(ENTRY_POINT)) {
+            return std::nullopt;
+        }
+
+        std::set<string> reachable{ ENTRY_POINT };
+        std::vector<string> pending{ ENTRY_POINT };
+
+        // `g++ -MM` lists headers included transitively, so every source is expanded once
+        while (!pending.empty()) {
+            const string source{ pending.back() };
+            pending.pop_back();
+
+            for (const auto& header: graph.at(source)) {
+                const std::optional<string> paired_source{ get_paired_source(header) };
+
+                if (paired_source.has_value() && graph.contains(paired_source.value()) && reachable.insert(paired_source.value()).second) {
+                    pending.push_back(paired_source.value());
+                }
+            }
+        }
+
+        return reachable;
+    }
+}
@@ -12,8 +12,10 @@
 #include <vector>
 
 #include "assets/scaffold_texts.hpp"
+#include "workspace/file_snapshot.hpp"
 #include "workspace/modification_identifier.hpp"
 #include "workspace/project_config.hpp"
+#include "workspace/trace.hpp"
 #include "workspace/util.hpp"
 
 namespace {
@@ -86,6 +88,10 @@ namespace {
             return remove_raw_literal_indentations(ENV_TEMPLATE);
         } else if (file_name.starts_with("environments/") && file_name.ends_with(".env")) {
             return remove_raw_literal_indentations(ENV_FILE);
+        } else if (file_name.compare("headers/cbt_tools/alloc_tracker.hpp") == 0) {
+            return remove_raw_literal_indentations(CBT_TOOLS_ALLOC_TRACKER_HPP);
+        } else if (file_name.compare("headers/cbt_tools/bench_harness.hpp") == 0) {
+            return remove_raw_literal_indentations(CBT_TOOLS_BENCH_HARNESS_HPP);
         } else if (file_name.compare("headers/cbt_tools/env_manager.hpp") == 0) {
             return remove_raw_literal_indentations(CBT_TOOLS_ENV_MANAGER_HPP);
         } else if (file_name.compare("headers/cbt_tools/test_harness.hpp") == 0) {
@@ -159,6 +165,8 @@ namespace {
             const string final_text = std::regex_replace(with_relative_import, NAMESPACE_R, scoped_namespace_name);
             
             return final_text;
+        } else if (file_name.starts_with("tests/benchmarks/")) {
+            return remove_raw_literal_indentations(SAMPLE_BENCHMARK_CPP);
         } else if (file_name.ends_with(".c")) {
             const string text{ remove_raw_literal_indentations(SAMPLE_C) };
             const auto [stemmed_name, _1, _2] = workspace::util::get_qualified_names(file_name, true);
@@ -276,13 +284,28 @@ namespace workspace::scaffold {
         if (!fs::exists("build/test_binaries/unit_tests")) {
             workspace::scaffold::create_directory("", "build/test_binaries/unit_tests", false, false);
         }
+        if (!fs::exists("build/test_binaries/benchmarks")) {
+            workspace::scaffold::create_directory("", "build/test_binaries/benchmarks", false, false);
+        }
 
         if (!fs::exists("dependencies/")) {
             workspace::scaffold::create_directory("", "dependencies", false, false);
         }
     }
 
+    // Workspaces created by earlier versions of cbt lack the harness headers added since, which the tests and
+    // benchmarks include
+    void create_missing_tool_headers(const workspace::project_config::Project& project) {
+        for (const string header: { "headers/cbt_tools/alloc_tracker.hpp", "headers/cbt_tools/bench_harness.hpp", "headers/cbt_tools/test_harness.hpp" }) {
+            if (!fs::exists(header)) {
+                workspace::scaffold::create_file(project, header, true, true);
+            }
+        }
+    }
+
     void purge_old_binaries(const string& path, const workspace::modification_identifier::SourceFiles& annotated_files) {
+        const workspace::trace::Span span{ "purge_old_binaries" };
+
         if (path.compare("build/binaries/") != 0 && path.compare("build/test_binaries/unit_tests/") != 0) {
             throw std::domain_error("Unknown path '" + path + "' provided for purging. Only 'build/binaries/' and 'build/test_binaries/unit_tests/' allowed.");
         }
@@ -290,7 +313,6 @@ namespace workspace::scaffold {
         std::vector<string> cpp_files{};
 
         const auto literal_length_of_src{ string("src/").length() };
-        const auto literal_length_of_binary_file_extension{ string(".o").length() };
 
         for (auto const& source_file: annotated_files) {
             const bool is_c_file{ source_file.file_name.ends_with(".c") };
@@ -298,14 +320,23 @@ namespace workspace::scaffold {
 
             if (source_file.file_name.ends_with(".c") || source_file.file_name.ends_with(".cpp")) {
                 cpp_files.push_back(source_file.file_name.substr(literal_length_of_src, source_file.file_name.length() - literal_length_of_src - literal_length_of_source_file_extension));
+            } else if (source_file.file_name.ends_with(".cppm")) {
+                // Module interfaces keep their extension in the object name
+                cpp_files.push_back(source_file.file_name.substr(literal_length_of_src));
             }
         }
 
-        for (auto const& dir_entry: fs::recursive_directory_iterator(path)) {
-            if (fs::is_regular_file(dir_entry)) {
-                const string binary_name{ workspace::util::get_platform_formatted_filename(dir_entry) };
+        bool has_removed_binaries{ false };
+
+        for (auto const& entry: workspace::file_snapshot::list_directory_recursively(path)) {
+            if (!workspace::file_snapshot::is_directory(entry)) {
+                const string binary_name{ workspace::util::get_platform_formatted_filename(entry) };
+
+                // Debug info split out of an object with `-gsplit-dwarf` goes along with it
+                const bool is_split_debug_info{ binary_name.ends_with(".dwo") };
 
-                if (binary_name.ends_with(".o")) {
+                if (binary_name.ends_with(".o") || is_split_debug_info) {
+                    const auto literal_length_of_binary_file_extension{ string(is_split_debug_info ? ".dwo" : ".o").length() };
                     const string stemmed_name{ binary_name.substr(path.length(), binary_name.length() - path.length() - literal_length_of_binary_file_extension) };
                     bool adjacent_binary_found{ false };
 
@@ -317,11 +348,16 @@ namespace workspace::scaffold {
                     }
 
                     if (!adjacent_binary_found) {
-                        fs::remove(dir_entry);
+                        fs::remove(entry);
+                        has_removed_binaries = true;
                     }
                 }
             }
         }
+
+        if (has_removed_binaries) {
+            workspace::file_snapshot::invalidate(path);
+        }
     }
 
     void remove_dependency(const string& dependency, const string& version) {
@@ -0,0 +1,107 @@
+#include "workspace/test_libraries.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "workspace/file_snapshot.hpp"
+#include "workspace/unity_build.hpp"
+#include "workspace/util.hpp"
+
+namespace {
+    using namespace workspace::test_libraries;
+
+    namespace fs = std::filesystem;
+
+    const string PROJECT_LIBRARY_NAME{ "project" };
+
+    string read_file(const fs::path& path) {
+        std::ifstream stream(path, std::ios::binary);
+        std::ostringstream content;
+        content << stream.rdbuf();
+
+        return content.str();
+    }
+
+    void list_objects_under(std::vector<string>& objects, const string& path) {
+        if (!workspace::file_snapshot::exists(path)) {
+            return;
+        }
+
+        for (const auto& entry: workspace::file_snapshot::list_directory_recursively(path)) {
+            if (!workspace::file_snapshot::is_directory(entry) && entry.ends_with(".o")) {
+                objects.push_back(workspace::util::get_platform_formatted_filename(entry));
+            }
+        }
+    }
+
+    Library make_library(const string& name, std::vector<string> objects, const std::vector<string>& libraries) {
+        const fs::path manifest{ fs::path(TEST_LIBRARIES_PATH) / ("lib" + name + ".objects") };
+
+        std::ranges::sort(objects);
+
+        string content{};
+
+        for (const auto& object: objects) {
+            content += object + "\n";
+        }
+
+        if (!fs::exists(manifest) || read_file(manifest) != content) {
+            std::ofstream(manifest, std::ios::binary) << content;
+            workspace::file_snapshot::invalidate(manifest.generic_string());
+        }
+
+        return Library{
+            .file{ (fs::path(TEST_LIBRARIES_PATH) / ("lib" + name + ".so")).generic_string() },
+            .objects{ objects },
+            .libraries{ libraries },
+            .manifest{ manifest.generic_string() }
+        };
+    }
+}
+
+namespace workspace::test_libraries {
+    std::vector<Library> plan() {
+        std::vector<Library> libraries{};
+        std::vector<string> dependency_libraries{};
+
+        if (workspace::file_snapshot::exists("build/dependencies")) {
+            for (const auto& entry: workspace::file_snapshot::list_directory("build/dependencies")) {
+                if (!workspace::file_snapshot::is_directory(entry)) {
+                    continue;
+                }
+
+                std::vector<string> objects{};
+                list_objects_under(objects, entry);
+
+                if (!objects.empty()) {
+                    libraries.push_back(make_library(fs::path(entry).filename().string(), objects, {}));
+                    dependency_libraries.push_back(libraries.back().file);
+                }
+            }
+        }
+
+        std::vector<string> objects{};
+
+        list_objects_under(objects, "build/binaries");
+        list_objects_under(objects, workspace::unity_build::UNITY_PATH);
+
+        // Tests bring their own `main()`
+        std::erase(objects, workspace::util::get_platform_formatted_filename(string("build/binaries/main.o")));
+
+        libraries.push_back(make_library(PROJECT_LIBRARY_NAME, objects, dependency_libraries));
+
+        return libraries;
+    }
+
+    bool is_supported() {
+        #if defined(_WIN32) || defined(_WIN64)
+        return false;
+        #else
+        return true;
+        #endif
+    }
+}
@@ -0,0 +1,212 @@
+#include "workspace/test_runner.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "workspace/file_snapshot.hpp"
+#include "workspace/unity_build.hpp"
+#include "workspace/util.hpp"
+
+namespace {
+    using namespace workspace::test_runner;
+
+    namespace fs = std::filesystem;
+
+    const string ENTRY_POINT_HEADER_NAME{ "cbt_entry_point.hpp" };
+    const string RUNNER_SOURCE_NAME{ "cbt_test_runner.cpp" };
+    const string MANIFEST_NAME{ "objects.txt" };
+
+    // `main()` may take no parameters or `argc` and `argv`, so both mangled forms of the entry point are looked up
+    string generate_source() {
+        const string mangled_entry_point{ "_Z" + std::to_string(ENTRY_POINT.length()) + ENTRY_POINT };
+
+        return string("// CBT generated. DO NOT EDIT!\n")
+            + "#include <cerrno>\n"
+            + "#include <cstdio>\n"
+            + "#include <cstdlib>\n"
+            + "#include <cstring>\n"
+            + "#include <exception>\n"
+            + "#include <iomanip>\n"
+            + "#include <iostream>\n"
+            + "\n"
+            + "#include <dlfcn.h>\n"
+            + "#include <sys/wait.h>\n"
+            + "#include <unistd.h>\n"
+            + "\n"
+            + "namespace {\n"
+            + "    const char* const ENTRY_POINT{ \"" + mangled_entry_point + "v\" };\n"
+            + "    const char* const ENTRY_POINT_WITH_ARGUMENTS{ \"" + mangled_entry_point + "iPPc\" };\n"
+            + "\n"
+            + "    void report_failure(const char* reason) {\n"
+            + "        std::cout << std::right << std::setw(8) << \"FAIL \" << reason << std::endl;\n"
+            + "    }\n"
+            + "\n"
+            + "    int run_suite(const char* suite, char* program) {\n"
+            + "        void* const handle{ dlopen(suite, RTLD_NOW | RTLD_LOCAL) };\n"
+            + "\n"
+            + "        if (handle == nullptr) {\n"
+            + "            report_failure(dlerror());\n"
+            + "            return EXIT_FAILURE;\n"
+            + "        }\n"
+            + "\n"
+            + "        try {\n"
+            + "            if (void* const entry_point = dlsym(handle, ENTRY_POINT)) {\n"
+            + "                return reinterpret_cast<int (*)()>(entry_point)();\n"
+            + "            }\n"
+            + "\n"
+            + "            if (void* const entry_point = dlsym(handle, ENTRY_POINT_WITH_ARGUMENTS)) {\n"
+            + "                char* arguments[]{ program, nullptr };\n"
+            + "                return reinterpret_cast<int (*)(int, char**)>(entry_point)(1, arguments);\n"
+            + "            }\n"
+            + "\n"
+            + "            report_failure(\"No 'main()' found\");\n"
+            + "        } catch (const std::exception& e) {\n"
+            + "            report_failure(e.what());\n"
+            + "        } catch (...) {\n"
+            + "            report_failure(\"<unknown exception>\");\n"
+            + "        }\n"
+            + "\n"
+            + "        return EXIT_FAILURE;\n"
+            + "    }\n"
+            + "\n"
+            + "    // A crashing or exiting suite only takes its own process down\n"
+            + "    int run_isolated_suite(const char* suite, char* program) {\n"
+            + "        std::cout.flush();\n"
+            + "\n"
+            + "        const pid_t child{ fork() };\n"
+            + "\n"
+            + "        if (child < 0) {\n"
+            + "            report_failure(std::strerror(errno));\n"
+            + "            return EXIT_FAILURE;\n"
+            + "        }\n"
+            + "\n"
+            + "        if (child == 0) {\n"
+            + "            const int exit_code{ run_suite(suite, program) };\n"
+            + "\n"
+            + "            std::cout.flush();\n"
+            + "            std::fflush(nullptr);\n"
+            + "            _exit(exit_code);\n"
+            + "        }\n"
+            + "\n"
+            + "        int status{ 0 };\n"
+            + "\n"
+            + "        if (waitpid(child, &status, 0) < 0) {\n"
+            + "            report_failure(std::strerror(errno));\n"
+            + "            return EXIT_FAILURE;\n"
+            + "        }\n"
+            + "\n"
+            + "        if (WIFSIGNALED(status)) {\n"
+            + "            report_failure(strsignal(WTERMSIG(status)));\n"
+            + "            return EXIT_FAILURE;\n"
+            + "        }\n"
+            + "\n"
+            + "        return WIFEXITED(status) ? WEXITSTATUS(status) : EXIT_FAILURE;\n"
+            + "    }\n"
+            + "}\n"
+            + "\n"
+            + "// Usage: cbt_test_runner [--isolate] <suite.so>...\n"
+            + "int main(int argc, char* argv[]) {\n"
+            + "    const bool isolate{ argc > 1 && std::strcmp(argv[1], \"--isolate\") == 0 };\n"
+            + "    int failures{ 0 };\n"
+            + "\n"
+            + "    for (int suite = isolate ? 2 : 1; suite < argc; ++suite) {\n"
+            + "        if ((isolate ? run_isolated_suite(argv[suite], argv[0]) : run_suite(argv[suite], argv[0])) != EXIT_SUCCESS) {\n"
+            + "            ++failures;\n"
+            + "        }\n"
+            + "    }\n"
+            + "\n"
+            + "    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;\n"
+            + "}\n";
+    }
+
+    string read_file(const fs::path& path) {
+        std::ifstream stream(path, std::ios::binary);
+        std::ostringstream content;
+        content << stream.rdbuf();
+
+        return content.str();
+    }
+
+    void write_if_changed(const fs::path& file, const string& content) {
+        if (!fs::exists(file) || read_file(file) != content) {
+            fs::create_directories(file.parent_path());
+            std::ofstream(file, std::ios::binary) << content;
+        }
+    }
+
+    void list_objects_under(std::vector<string>& objects, const string& path) {
+        if (!workspace::file_snapshot::exists(path)) {
+            return;
+        }
+
+        for (const auto& entry: workspace::file_snapshot::list_directory_recursively(path)) {
+            if (!workspace::file_snapshot::is_directory(entry) && entry.ends_with(".o")) {
+                objects.push_back(workspace::util::get_platform_formatted_filename(entry));
+            }
+        }
+    }
+}
+
+namespace workspace::test_runner {
+    Mode get_mode(const workspace::project_config::Project& project) {
+        const string mode{ project.config.unit_test_runner.value_or("executables") };
+
+        return mode == "aggregated" ? Mode::AGGREGATED : (mode == "isolated" ? Mode::ISOLATED : Mode::EXECUTABLES);
+    }
+
+    bool is_supported() {
+        #if defined(_WIN32) || defined(_WIN64)
+        return false;
+        #else
+        return true;
+        #endif
+    }
+
+    string write_entry_point_header() {
+        const fs::path header{ fs::path(TEST_RUNNER_PATH) / ENTRY_POINT_HEADER_NAME };
+
+        write_if_changed(header, "// CBT generated. DO NOT EDIT!\n#define main " + ENTRY_POINT + "\n");
+
+        return header.generic_string();
+    }
+
+    string write_source() {
+        const fs::path source{ fs::path(TEST_RUNNER_PATH) / RUNNER_SOURCE_NAME };
+
+        write_if_changed(source, generate_source());
+
+        return source.generic_string();
+    }
+
+    std::vector<string> list_objects() {
+        std::vector<string> objects{};
+
+        list_objects_under(objects, "build/binaries");
+        list_objects_under(objects, "build/dependencies");
+        list_objects_under(objects, workspace::unity_build::UNITY_PATH);
+
+        // Tests bring their own `main()`
+        std::erase(objects, workspace::util::get_platform_formatted_filename(string("build/binaries/main.o")));
+        std::ranges::sort(objects);
+
+        return objects;
+    }
+
+    string write_manifest(const std::vector<string>& objects) {
+        const fs::path manifest{ fs::path(TEST_RUNNER_PATH) / MANIFEST_NAME };
+
+        string content{};
+
+        for (const auto& object: objects) {
+            content += object + "\n";
+        }
+
+        write_if_changed(manifest, content);
+
+        return manifest.generic_string();
+    }
+}
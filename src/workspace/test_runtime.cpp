@@ -0,0 +1,150 @@
+#include "workspace/test_runtime.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <system_error>
+
+#include "gnu_toolchain.hpp"
+
+namespace {
+    using namespace workspace::test_runtime;
+
+    namespace fs = std::filesystem;
+
+    const string TEST_HARNESS{ "headers/cbt_tools/test_harness.hpp" };
+    const string ALLOC_TRACKER{ "headers/cbt_tools/alloc_tracker.hpp" };
+
+    const string RUNTIME_HEADER_NAME{ "cbt_test_runtime.hpp" };
+    const string RUNTIME_SOURCE_NAME{ "cbt_test_runtime.cpp" };
+    const string RUNTIME_OBJECT_NAME{ "cbt_test_runtime.o" };
+
+    // Resolved through '-iquoteheaders', so the test's own include of the harness is a no-op
+    const string RUNTIME_HEADER_CONTENT{ "// CBT generated. DO NOT EDIT!\n#include \"cbt_tools/test_harness.hpp\"\n" };
+    const string RUNTIME_SOURCE_CONTENT{ "// CBT generated. DO NOT EDIT!\n#include \"cbt_tools/alloc_tracker.hpp\"\n" };
+
+    string read_file(const fs::path& path) {
+        std::ifstream stream(path, std::ios::binary);
+        std::ostringstream content;
+        content << stream.rdbuf();
+
+        return content.str();
+    }
+
+    // Projects scaffolded before the hooks could be compiled apart would end up defining them twice
+    bool can_prebuild_allocation_hooks() {
+        return read_file(ALLOC_TRACKER).find("CBT_PREBUILT_TEST_RUNTIME") != string::npos;
+    }
+
+    string get_flags_key(const workspace::project_config::Project& project, const bool track_allocations, const bool position_independent, const bool has_object) {
+        string command{ gnu_toolchain::get_test_execution_command(project, "", track_allocations) };
+
+        // The linker has no say in what the runtime compiles to
+        if (const string linker_flags{ gnu_toolchain::get_linker_flags(project) }; !linker_flags.empty()) {
+            command.erase(command.find(linker_flags), linker_flags.length());
+        }
+
+        std::ostringstream key;
+        key << std::hex << std::hash<string>{}(command + (position_independent ? " -fPIC" : "") + (has_object ? " +object" : ""));
+
+        return key.str();
+    }
+
+    // The dependency file written alongside lists every header parsed into the output
+    bool is_outdated(const fs::path& output, const fs::path& dependency_file) {
+        std::error_code error;
+        const fs::file_time_type built_at{ fs::last_write_time(output, error) };
+
+        if (error || !fs::exists(dependency_file)) {
+            return true;
+        }
+
+        std::istringstream dependencies{ read_file(dependency_file) };
+        string token;
+
+        // Skips the target
+        dependencies >> token;
+
+        while (dependencies >> token) {
+            if (token == "\\") {
+                continue;
+            }
+
+            const fs::file_time_type last_write_time{ fs::last_write_time(token, error) };
+
+            if (error || last_write_time > built_at) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void write_if_changed(const fs::path& file, const string& content) {
+        if (!fs::exists(file) || read_file(file) != content) {
+            std::ofstream(file, std::ios::binary) << content;
+        }
+    }
+}
+
+namespace workspace::test_runtime {
+    std::optional<TestRuntime> prepare(const workspace::project_config::Project& project, const bool track_allocations, const bool position_independent) {
+        if (!fs::exists(TEST_HARNESS)) {
+            return std::nullopt;
+        }
+
+        const bool has_object{ track_allocations && can_prebuild_allocation_hooks() };
+
+        const fs::path directory{ fs::path(TEST_RUNTIME_PATH) / get_flags_key(project, track_allocations, position_independent, has_object) };
+        const fs::path header{ directory / RUNTIME_HEADER_NAME };
+        const fs::path precompiled_header{ directory / (RUNTIME_HEADER_NAME + ".gch") };
+        const fs::path header_dependency_file{ directory / (RUNTIME_HEADER_NAME + ".d") };
+        const fs::path source{ directory / RUNTIME_SOURCE_NAME };
+        const fs::path object{ directory / RUNTIME_OBJECT_NAME };
+        const fs::path object_dependency_file{ directory / (RUNTIME_SOURCE_NAME + ".d") };
+
+        TestRuntime result{
+            .header{ header.generic_string() },
+            .object{ has_object ? std::optional<string>{ object.generic_string() } : std::nullopt },
+            .was_rebuilt{ false },
+            .was_successful{ true },
+            .build_time{ 0 }
+        };
+
+        const bool is_header_outdated{ is_outdated(precompiled_header, header_dependency_file) };
+        const bool is_object_outdated{ has_object && is_outdated(object, object_dependency_file) };
+
+        if (!is_header_outdated && !is_object_outdated) {
+            return result;
+        }
+
+        fs::create_directories(directory);
+
+        const auto start{ std::chrono::steady_clock::now() };
+
+        result.was_rebuilt = true;
+
+        if (is_header_outdated) {
+            write_if_changed(header, RUNTIME_HEADER_CONTENT);
+            result.was_successful = gnu_toolchain::precompile_test_runtime_header(project, result.header, precompiled_header.generic_string(), header_dependency_file.generic_string(), track_allocations, position_independent) == 0;
+        }
+
+        if (result.was_successful && is_object_outdated) {
+            write_if_changed(source, RUNTIME_SOURCE_CONTENT);
+            result.was_successful = gnu_toolchain::compile_test_runtime(project, source.generic_string(), object.generic_string(), object_dependency_file.generic_string(), track_allocations, position_independent) == 0;
+        }
+
+        result.build_time = static_cast<std::size_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+
+        if (!result.was_successful) {
+            // Otherwise a stale one would be picked up by the next compilation
+            fs::remove(precompiled_header);
+            fs::remove(object);
+        }
+
+        return result;
+    }
+}
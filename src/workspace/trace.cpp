@@ -0,0 +1,190 @@
+#include "workspace/trace.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+    using namespace workspace::trace;
+
+    namespace cr = std::chrono;
+
+    struct Event {
+        string name;
+        string category;
+        long long start;
+        long long duration;
+        unsigned int lane;
+        Arguments arguments;
+    };
+
+    string escape(const string& text) {
+        std::ostringstream escaped;
+
+        for (const char c: text) {
+            switch (c) {
+                case '"': escaped << "\\\""; break;
+                case '\\': escaped << "\\\\"; break;
+                case '\n': escaped << "\\n"; break;
+                case '\r': escaped << "\\r"; break;
+                case '\t': escaped << "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        escaped << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+                    } else {
+                        escaped << c;
+                    }
+            }
+        }
+
+        return escaped.str();
+    }
+
+    // Events are buffered and written out once, when the recorder is destroyed at exit
+    class Recorder {
+    public:
+        Recorder() {
+            restart();
+        }
+
+        ~Recorder() {
+            finish();
+        }
+
+        void restart() {
+            const char* trace_file{ std::getenv(OUTPUT_VARIABLE.c_str()) };
+
+            origin = Clock::now();
+            output_file = trace_file != nullptr && *trace_file != '\0' ? std::optional<string>{ trace_file } : std::nullopt;
+            events.clear();
+        }
+
+        void finish() {
+            if (output_file.has_value()) {
+                write();
+            }
+
+            output_file = std::nullopt;
+            events.clear();
+        }
+
+        bool is_enabled() const {
+            return output_file.has_value();
+        }
+
+        void add(Event&& event) {
+            events.push_back(std::move(event));
+        }
+
+        long long to_microseconds(const Clock::time_point time_point) const {
+            return cr::duration_cast<cr::microseconds>(time_point - origin).count();
+        }
+
+    private:
+        void write() const {
+            #if defined(_WIN32) || defined(_WIN64)
+            const int pid{ _getpid() };
+            #else
+            const int pid{ static_cast<int>(getpid()) };
+            #endif
+
+            std::ofstream trace(output_file.value());
+            std::set<unsigned int> lanes{ 0 };
+
+            trace << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+            for (std::size_t i = 0; i < events.size(); ++i) {
+                const Event& event{ events[i] };
+
+                trace << (i == 0 ? "" : ",") << "\n{\"name\":\"" << escape(event.name) << "\",\"cat\":\"" << escape(event.category)
+                    << "\",\"ph\":\"X\",\"ts\":" << event.start << ",\"dur\":" << event.duration
+                    << ",\"pid\":" << pid << ",\"tid\":" << event.lane << ",\"args\":{";
+
+                for (std::size_t j = 0; j < event.arguments.size(); ++j) {
+                    trace << (j == 0 ? "" : ",") << "\"" << escape(event.arguments[j].first) << "\":\"" << escape(event.arguments[j].second) << "\"";
+                }
+
+                trace << "}}";
+
+                lanes.insert(event.lane);
+            }
+
+            for (const unsigned int lane: lanes) {
+                trace << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << lane
+                    << ",\"args\":{\"name\":\"" << (lane == 0 ? string("cbt") : "job slot " + std::to_string(lane - 1)) << "\"}}";
+            }
+
+            trace << "\n]}\n";
+        }
+
+        Clock::time_point origin{};
+        std::optional<string> output_file{ std::nullopt };
+        std::vector<Event> events{};
+    };
+
+    Recorder& get_recorder() {
+        static Recorder recorder;
+
+        return recorder;
+    }
+
+    // Creating the recorder first keeps every timestamp after its origin
+    Clock::time_point now() {
+        get_recorder();
+
+        return Clock::now();
+    }
+}
+
+namespace workspace::trace {
+    bool is_enabled() {
+        return get_recorder().is_enabled();
+    }
+
+    void restart() {
+        get_recorder().restart();
+    }
+
+    void finish() {
+        get_recorder().finish();
+    }
+
+    void record(const string& name, const string& category, const Clock::time_point start, const Clock::time_point end, const unsigned int lane, const Arguments& arguments) {
+        Recorder& recorder{ get_recorder() };
+
+        if (!recorder.is_enabled()) {
+            return;
+        }
+
+        const long long start_us{ recorder.to_microseconds(start) };
+
+        recorder.add(Event{
+            .name{ name },
+            .category{ category },
+            .start{ start_us },
+            .duration{ recorder.to_microseconds(end) - start_us },
+            .lane{ lane },
+            .arguments{ arguments }
+        });
+    }
+
+    Span::Span(const string& name, const Arguments& arguments): name{ name }, arguments{ arguments }, start{ now() } {}
+
+    Span::~Span() {
+        record(name, "phase", start, Clock::now(), 0, arguments);
+    }
+}
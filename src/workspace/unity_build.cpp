@@ -0,0 +1,417 @@
+#include "workspace/unity_build.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    using namespace workspace::unity_build;
+
+    namespace fs = std::filesystem;
+
+    using workspace::modification_identifier::RawDependencyTree;
+
+    const string MANIFEST_PATH{ ".internals/unity.txt" };
+    const string LOOSE_FILES_ENTRY{ "loose" };
+
+    string read_file(const fs::path& path) {
+        std::ifstream stream(path, std::ios::binary);
+        std::ostringstream content;
+        content << stream.rdbuf();
+
+        return content.str();
+    }
+
+    // Keeps line breaks, so preprocessor directives still start their lines
+    string strip_comments_and_literals(const string& source) {
+        string stripped{};
+        stripped.reserve(source.length());
+
+        for (std::size_t i = 0; i < source.length(); ++i) {
+            if (source.compare(i, 2, "//") == 0) {
+                i = std::min(source.find('\n', i), source.length()) - 1;
+            } else if (source.compare(i, 2, "/*") == 0) {
+                const std::size_t end{ source.find("*/", i + 2) };
+                stripped += std::string(std::count(source.begin() + i, end == string::npos ? source.end() : source.begin() + end, '\n'), '\n');
+                i = end == string::npos ? source.length() : end + 1;
+            } else if (source[i] == '"' || source[i] == '\'') {
+                const char quote{ source[i] };
+
+                for (++i; i < source.length() && source[i] != quote && source[i] != '\n'; ++i) {
+                    i += source[i] == '\\' ? 1 : 0;
+                }
+
+                stripped += ' ';
+            } else {
+                stripped += source[i];
+            }
+        }
+
+        return stripped;
+    }
+
+    // Name declared by the start of a statement, e.g. 'helper' for 'static int helper(const int x)'
+    std::optional<string> get_declared_name(const string& head) {
+        if (head.find("operator") != string::npos || head.starts_with("using namespace") || head.starts_with("namespace")) {
+            return std::nullopt;
+        }
+
+        const string declarator{ head.substr(0, head.find_first_of("(=[{")) };
+
+        static const std::regex identifier{ R"re([A-Za-z_]\w*)re" };
+        std::optional<string> name{ std::nullopt };
+
+        for (auto it = std::sregex_iterator(declarator.begin(), declarator.end(), identifier); it != std::sregex_iterator(); ++it) {
+            name = it->str();
+        }
+
+        return name;
+    }
+
+    string trim(const string& text) {
+        const std::size_t start{ text.find_first_not_of(" \t\r\n") };
+
+        return start == string::npos ? "" : text.substr(start, text.find_last_not_of(" \t\r\n") - start + 1);
+    }
+
+    enum class Scope {
+        ANONYMOUS_NAMESPACE,
+        NAMESPACE,
+        OTHER
+    };
+
+    // Names with internal linkage a batch would put in the same scope: members of anonymous namespaces,
+    // `static` declarations at namespace scope and macros defined by the implementation file itself
+    std::set<string> list_internal_names(const string& file) {
+        const string source{ strip_comments_and_literals(read_file(file)) };
+
+        std::set<string> names{};
+
+        static const std::regex define_pattern{ R"re(^\s*#\s*define\s+([A-Za-z_]\w*))re" };
+
+        std::istringstream lines{ source };
+        string code{};
+
+        for (string line; std::getline(lines, line); ) {
+            if (std::smatch match; std::regex_search(line, match, define_pattern)) {
+                names.insert(match[1].str());
+            }
+
+            if (!trim(line).starts_with("#")) {
+                code += line + '\n';
+            }
+        }
+
+        std::vector<Scope> scopes{};
+        string statement{};
+
+        const auto is_internal_scope = [&scopes](const string& head) {
+            if (!scopes.empty() && scopes.back() == Scope::ANONYMOUS_NAMESPACE) {
+                return true;
+            }
+
+            return head.starts_with("static ") && std::ranges::none_of(scopes, [](const Scope scope) { return scope == Scope::OTHER; });
+        };
+
+        for (const char character: code) {
+            if (character == '{' || character == ';') {
+                const string head{ trim(statement) };
+
+                if (is_internal_scope(head)) {
+                    if (const auto name = get_declared_name(head); name.has_value()) {
+                        names.insert(name.value());
+                    }
+                }
+
+                if (character == '{') {
+                    scopes.push_back(head == "namespace" ? Scope::ANONYMOUS_NAMESPACE : (head.starts_with("namespace ") ? Scope::NAMESPACE : Scope::OTHER));
+                }
+
+                statement.clear();
+            } else if (character == '}') {
+                if (!scopes.empty()) {
+                    scopes.pop_back();
+                }
+
+                statement.clear();
+            } else {
+                statement += character;
+            }
+        }
+
+        return names;
+    }
+
+    std::size_t count_shared(const std::set<string>& lhs, const std::set<string>& rhs) {
+        std::size_t shared{ 0 };
+
+        for (const auto& item: lhs) {
+            shared += rhs.contains(item) ? 1 : 0;
+        }
+
+        return shared;
+    }
+
+    bool intersects(const std::set<string>& lhs, const std::set<string>& rhs) {
+        return std::ranges::any_of(lhs, [&rhs](const auto& item) { return rhs.contains(item); });
+    }
+
+    // Greedily grows each batch with the file sharing the most includes with it, seeding every batch with the
+    // file including the most, so the headers parsed once serve as many files as possible
+    std::vector<std::vector<string>> form_batches(const RawDependencyTree& sources, const std::vector<string>& candidates, const std::size_t batch_size, std::vector<Collision>& collisions) {
+        std::map<string, std::set<string>> includes{};
+        std::map<string, std::set<string>> internal_names{};
+        std::map<string, std::vector<string>> definitions{};
+
+        for (const auto& file: candidates) {
+            const auto it{ sources.find(file) };
+
+            includes[file] = it != sources.end() ? std::set<string>(it->second.begin(), it->second.end()) : std::set<string>{};
+            internal_names[file] = list_internal_names(file);
+
+            for (const auto& name: internal_names[file]) {
+                definitions[name].push_back(file);
+            }
+        }
+
+        for (const auto& [name, files]: definitions) {
+            if (files.size() > 1) {
+                collisions.push_back(Collision{ .name{ name }, .files{ files } });
+            }
+        }
+
+        std::set<string> remaining(candidates.begin(), candidates.end());
+        std::vector<std::vector<string>> batches{};
+
+        while (!remaining.empty()) {
+            const string seed{ *std::ranges::max_element(remaining, {}, [&includes](const string& file) { return includes[file].size(); }) };
+
+            std::vector<string> batch{ seed };
+            std::set<string> batch_includes{ includes[seed] };
+            std::set<string> batch_names{ internal_names[seed] };
+
+            remaining.erase(seed);
+
+            while (batch.size() < batch_size) {
+                std::optional<string> best{ std::nullopt };
+                std::size_t best_shared{ 0 };
+
+                for (const auto& file: remaining) {
+                    if (intersects(internal_names[file], batch_names)) {
+                        continue;
+                    }
+
+                    if (const std::size_t shared = count_shared(includes[file], batch_includes); !best.has_value() || shared > best_shared) {
+                        best = file;
+                        best_shared = shared;
+                    }
+                }
+
+                if (!best.has_value()) {
+                    break;
+                }
+
+                batch.push_back(best.value());
+                batch_includes.insert(includes[best.value()].begin(), includes[best.value()].end());
+                batch_names.insert(internal_names[best.value()].begin(), internal_names[best.value()].end());
+
+                remaining.erase(best.value());
+            }
+
+            std::sort(batch.begin(), batch.end());
+            batches.push_back(batch);
+        }
+
+        return batches;
+    }
+
+    string generate_content(const std::vector<string>& members) {
+        // Relative to the batch, which lives two levels down from the project root
+        const string PROJECT_ROOT{ "../../" };
+
+        string content{ "// CBT generated. DO NOT EDIT!\n" };
+
+        for (const auto& member: members) {
+            content += "#include \"" + PROJECT_ROOT + member + "\"\n";
+        }
+
+        return content;
+    }
+
+    string get_batch_file(const std::size_t index) {
+        return UNITY_PATH + "/batch_" + std::to_string(index) + ".cpp";
+    }
+
+    // e.g. 'src/a/b.cpp' is compiled on its own to 'build/binaries/a/b.o'
+    string get_own_object(const string& file) {
+        return fs::path("build/binaries/" + file.substr(string("src/").length())).replace_extension(".o").generic_string();
+    }
+
+    std::optional<Plan> load_plan() {
+        if (!fs::exists(MANIFEST_PATH)) {
+            return std::nullopt;
+        }
+
+        std::ifstream manifest(MANIFEST_PATH);
+        Plan plan{};
+
+        for (string line; std::getline(manifest, line); ) {
+            std::erase(line, '\r');
+
+            if (line.empty() || line.starts_with(";")) {
+                continue;
+            }
+
+            const std::size_t separator{ line.find('|') };
+
+            std::vector<string> files{};
+            std::istringstream list{ line.substr(separator + 1) };
+
+            for (string file; std::getline(list, file, ','); ) {
+                files.push_back(file);
+            }
+
+            if (line.substr(0, separator) == LOOSE_FILES_ENTRY) {
+                plan.loose_files = files;
+            } else {
+                plan.batches.push_back(Batch{ .file{ line.substr(0, separator) }, .members{ files }, .needs_compilation{ false } });
+            }
+        }
+
+        return plan;
+    }
+
+    string join(const std::vector<string>& items) {
+        string joined{};
+
+        for (const auto& item: items) {
+            joined += (joined.empty() ? "" : ",") + item;
+        }
+
+        return joined;
+    }
+}
+
+namespace workspace::unity_build {
+    Plan plan(const RawDependencyTree& sources, const std::vector<string>& candidates, const std::set<string>& dirty_files, const std::size_t batch_size, std::vector<Collision>& collisions) {
+        const std::set<string> eligible(candidates.begin(), candidates.end());
+        const std::size_t dirty_candidates{ static_cast<std::size_t>(std::ranges::count_if(dirty_files, [&eligible](const auto& file) { return eligible.contains(file); })) };
+
+        const std::optional<Plan> last_plan{ load_plan() };
+        Plan plan{};
+
+        if (dirty_candidates * 2 >= candidates.size()) {
+            const auto batches{ form_batches(sources, candidates, batch_size, collisions) };
+
+            for (std::size_t index = 0; index < batches.size(); ++index) {
+                if (batches[index].size() == 1) {
+                    plan.loose_files.push_back(batches[index].front());
+                } else {
+                    plan.batches.push_back(Batch{ .file{ get_batch_file(index) }, .members{ batches[index] }, .needs_compilation{ false } });
+                }
+            }
+        } else {
+            std::set<string> batched{};
+
+            for (const auto& batch: last_plan.value_or(Plan{}).batches) {
+                Batch kept{ .file{ batch.file }, .members{}, .needs_compilation{ false } };
+
+                std::ranges::copy_if(batch.members, std::back_inserter(kept.members),
+                    [&eligible, &dirty_files](const auto& member) { return eligible.contains(member) && !dirty_files.contains(member); }
+                );
+
+                if (kept.members.size() >= 2) {
+                    batched.insert(kept.members.begin(), kept.members.end());
+                    plan.batches.push_back(kept);
+                }
+            }
+
+            std::ranges::copy_if(candidates, std::back_inserter(plan.loose_files), [&batched](const auto& file) { return !batched.contains(file); });
+        }
+
+        for (auto& batch: plan.batches) {
+            batch.needs_compilation = !fs::exists(get_object(batch))
+                || read_file(batch.file) != generate_content(batch.members)
+                || std::ranges::any_of(batch.members, [&dirty_files](const auto& member) { return dirty_files.contains(member); });
+        }
+
+        return plan;
+    }
+
+    void apply(const Plan& plan) {
+        fs::create_directories(UNITY_PATH);
+
+        std::set<string> batch_files{};
+
+        for (const auto& batch: plan.batches) {
+            batch_files.insert(batch.file);
+
+            if (const string content = generate_content(batch.members); read_file(batch.file) != content) {
+                std::ofstream(batch.file, std::ios::binary) << content;
+                fs::remove(get_object(batch));
+            }
+
+            // Linking it alongside the batch would define everything twice
+            for (const auto& member: batch.members) {
+                fs::remove(get_own_object(member));
+            }
+        }
+
+        for (const auto& entry: fs::directory_iterator(UNITY_PATH)) {
+            if (!batch_files.contains(fs::path(entry.path()).replace_extension(".cpp").generic_string())) {
+                fs::remove(entry.path());
+            }
+        }
+
+        fs::create_directories(fs::path(MANIFEST_PATH).parent_path());
+
+        std::ofstream manifest(MANIFEST_PATH);
+        manifest << "; CBT generated. DO NOT EDIT!\n";
+
+        for (const auto& batch: plan.batches) {
+            manifest << batch.file << "|" << join(batch.members) << "\n";
+        }
+
+        manifest << LOOSE_FILES_ENTRY << "|" << join(plan.loose_files) << "\n";
+    }
+
+    std::vector<string> discard() {
+        std::vector<string> batched_files{};
+
+        for (const auto& batch: load_plan().value_or(Plan{}).batches) {
+            batched_files.insert(batched_files.end(), batch.members.begin(), batch.members.end());
+        }
+
+        fs::remove_all(UNITY_PATH);
+        fs::remove(MANIFEST_PATH);
+
+        return batched_files;
+    }
+
+    string get_object(const Batch& batch) {
+        return fs::path(batch.file).replace_extension(".o").generic_string();
+    }
+
+    std::vector<string> list_loose_files_without_object(const Plan& plan) {
+        std::vector<string> files{};
+        std::ranges::copy_if(plan.loose_files, std::back_inserter(files), [](const auto& file) { return !fs::exists(get_own_object(file)); });
+
+        return files;
+    }
+
+    bool is_batched(const string& file) {
+        const string normalised_file{ fs::path(file).lexically_normal().generic_string() };
+
+        return std::ranges::any_of(load_plan().value_or(Plan{}).batches,
+            [&normalised_file](const auto& batch) { return std::ranges::find(batch.members, normalised_file) != batch.members.end(); }
+        );
+    }
+}
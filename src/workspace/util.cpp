@@ -3,13 +3,24 @@
 #include <algorithm>
 #include <cctype>
 #include <chrono>
+#include <cstdlib>
 #include <filesystem>
+#include <fstream>
 #include <functional>
 #include <iostream>
+#include <optional>
 #include <regex>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <tuple>
+#include <unordered_map>
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <unistd.h>
+#endif
+
+#include "workspace/file_snapshot.hpp"
 
 namespace workspace::util {
     using std::string;
@@ -194,8 +205,31 @@ namespace workspace::util {
         return get_platform_formatted_filename(std::filesystem::path(file_name));
     }
 
+    // Resolving walks every component of the path, so it's skipped where the snapshot shows there are no links
+    // to resolve and results are remembered per working directory
     string get_platform_formatted_filename(std::filesystem::path path) {
-        return std::filesystem::relative(std::filesystem::canonical(path)).make_preferred().string();
+        static std::unordered_map<string, string> formatted_filenames{};
+
+        const string key{ std::filesystem::current_path().string() + '\0' + path.string() };
+
+        if (const auto it = formatted_filenames.find(key); it != formatted_filenames.end()) {
+            return it->second;
+        }
+
+        string formatted_filename{};
+
+        if (workspace::file_snapshot::is_free_of_symlinks(path)) {
+            formatted_filename = path.lexically_normal().make_preferred().string();
+
+            while (formatted_filename.length() > 1 && formatted_filename.ends_with(std::filesystem::path::preferred_separator)) {
+                formatted_filename.pop_back();
+            }
+        } else {
+            formatted_filename = std::filesystem::relative(std::filesystem::canonical(path)).make_preferred().string();
+        }
+        formatted_filenames.emplace(key, formatted_filename);
+
+        return formatted_filename;
     }
 
     string get_ISO_date() {
@@ -232,4 +266,58 @@ namespace workspace::util {
 
         return ymd;
     }
+
+    string get_machine_identity() {
+        #if defined(_WIN32) || defined(_WIN64)
+        const char* host_name{ std::getenv("COMPUTERNAME") };
+        const string name{ host_name != nullptr ? host_name : "<unknown-host>" };
+        #else
+        char host_name[256]{};
+        const string name{ gethostname(host_name, sizeof(host_name) - 1) == 0 ? host_name : "<unknown-host>" };
+        #endif
+
+        return name + " (" + std::to_string(std::thread::hardware_concurrency()) + " hardware threads)";
+    }
+
+    void set_env(const string& key, const string& value) {
+        #if defined(_WIN32) || defined(_WIN64)
+        _putenv_s(key.c_str(), value.c_str());
+        #else
+        setenv(key.c_str(), value.c_str(), 1);
+        #endif
+    }
+
+    std::optional<std::size_t> parse_memory_size(const string& text) {
+        const std::regex pattern("^(\\d+)\\s*([kKmMgGtT]?)[bB]?$");
+        std::smatch match;
+
+        if (!std::regex_match(text, match, pattern)) {
+            return std::nullopt;
+        }
+
+        const string unit{ match[2].str() };
+        const std::size_t exponent{ unit.empty() ? 0 : string("kmgt").find(static_cast<char>(std::tolower(unit[0]))) + 1 };
+
+        return std::stoull(match[1].str()) << (10 * exponent);
+    }
+
+    std::size_t get_available_memory() {
+        #if defined(__linux__)
+        std::ifstream meminfo("/proc/meminfo");
+        string line;
+
+        while (std::getline(meminfo, line)) {
+            if (line.starts_with("MemAvailable:")) {
+                return std::stoull(line.substr(string("MemAvailable:").length())) * 1024;
+            }
+        }
+
+        return 0;
+        #elif defined(_WIN32) || defined(_WIN64)
+        // Compilations run one at a time on Windows, so there is nothing to budget
+        return 0;
+        #else
+        return static_cast<std::size_t>(sysconf(_SC_PHYS_PAGES)) * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        #endif
+    }
 }
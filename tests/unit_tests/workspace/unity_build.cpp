@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../../../src/workspace/unity_build.cpp"
+
+namespace fs = std::filesystem;
+
+// Lays out a workspace whose four implementation files share a header, then steps into it, as the unity
+// build works with paths relative to the project root
+fs::path create_workspace() {
+    const fs::path root{ fs::temp_directory_path() / "cbt_unity_build_test" };
+
+    fs::remove_all(root);
+    fs::create_directories(root / "src");
+    fs::create_directories(root / "build/binaries");
+
+    for (const auto& name: { "a", "b", "c", "d" }) {
+        std::ofstream(root / "src" / (std::string(name) + ".cpp")) << "#include \"shared.hpp\"\n\nint " << name << "() { return 0; }\n";
+    }
+
+    fs::current_path(root);
+
+    return root;
+}
+
+void test_batch_shrinking_to_one_member() {
+    const std::vector<std::string> candidates{ "src/a.cpp", "src/b.cpp", "src/c.cpp", "src/d.cpp" };
+    const workspace::modification_identifier::RawDependencyTree sources{
+        { "src/a.cpp", { "headers/shared.hpp" } },
+        { "src/b.cpp", { "headers/shared.hpp" } },
+        { "src/c.cpp", { "headers/shared.hpp" } },
+        { "src/d.cpp", { "headers/shared.hpp" } }
+    };
+
+    std::vector<workspace::unity_build::Collision> collisions{};
+
+    // Every file is dirty on a clean build, so the batches are formed from scratch
+    const workspace::unity_build::Plan clean_plan{ workspace::unity_build::plan(sources, candidates, std::set<std::string>(candidates.begin(), candidates.end()), 2, collisions) };
+
+    assert((clean_plan.batches.size() == 2));
+    assert((clean_plan.loose_files.empty()));
+    assert((collisions.empty()));
+
+    workspace::unity_build::apply(clean_plan);
+
+    const auto former_batch{ std::ranges::find_if(clean_plan.batches, [](const auto& batch) { return std::ranges::find(batch.members, "src/a.cpp") != batch.members.end(); }) };
+    const std::string leftover_member{ former_batch->members.front() == "src/a.cpp" ? former_batch->members.back() : former_batch->members.front() };
+
+    // Editing one member takes it out of its batch, which is left with a single member and dissolved
+    const workspace::unity_build::Plan incremental_plan{ workspace::unity_build::plan(sources, candidates, { "src/a.cpp" }, 2, collisions) };
+
+    assert((incremental_plan.batches.size() == 1));
+    assert((std::ranges::find(incremental_plan.loose_files, leftover_member) != incremental_plan.loose_files.end()));
+
+    // The leftover member is clean, yet its object was removed when it was batched
+    const std::vector<std::string> files_without_object{ workspace::unity_build::list_loose_files_without_object(incremental_plan) };
+
+    assert((std::ranges::find(files_without_object, leftover_member) != files_without_object.end()));
+    assert((std::ranges::find(files_without_object, "src/a.cpp") != files_without_object.end()));
+
+    // Once compiled on its own, it is up-to-date again
+    std::ofstream(get_own_object(leftover_member)) << "";
+
+    const std::vector<std::string> files_still_without_object{ workspace::unity_build::list_loose_files_without_object(incremental_plan) };
+
+    assert((std::ranges::find(files_still_without_object, leftover_member) == files_still_without_object.end()));
+}
+
+int main() {
+    const fs::path initial_directory{ fs::current_path() };
+    const fs::path root{ create_workspace() };
+
+    std::cout << std::endl << std::setw(8) << "EXECUTE " << __FILE__ << std::endl << std::endl;
+
+    test_batch_shrinking_to_one_member();
+
+    fs::current_path(initial_directory);
+    fs::remove_all(root);
+
+    return EXIT_SUCCESS;
+}